@@ -10,6 +10,9 @@
 #include "Dialogs/PreferencesDialog.h"
 #include "EditorPreferences.h"
 #include "HorseEngine/Asset/AssetManager.h"
+#include "HorseEngine/Core/JobSystem.h"
+#include "HorseEngine/Core/Memory.h"
+#include "HorseEngine/Core/MemoryTracker.h"
 #include "HorseEngine/Core/Time.h"
 #include "HorseEngine/Render/D3D11Renderer.h"
 #include "HorseEngine/Render/MaterialRegistry.h"
@@ -86,6 +89,10 @@ void EditorWindow::UpdateSceneContext() {
 
 void EditorWindow::OnUpdate() {
   Horse::Time::Update();
+  Horse::ScratchArena::NewFrame();
+  Horse::JobSystem::BeginFrame();
+  Horse::JobSystem::PumpMainThread();
+  Horse::MemoryTracker::Update();
 
   if (m_ActiveScene) {
     m_ActiveScene->OnUpdate(Horse::Time::GetDeltaTime());
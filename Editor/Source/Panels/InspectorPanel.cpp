@@ -171,7 +171,7 @@ void InspectorPanel::DrawComponents() {
     std::vector<std::string> materialNames;
     for (const auto &[name, mat] :
          Horse::MaterialRegistry::Get().GetMaterials()) {
-      materialNames.push_back(name);
+      materialNames.push_back(name.GetString());
     }
     std::sort(materialNames.begin(), materialNames.end());
 
@@ -187,7 +187,7 @@ void InspectorPanel::DrawComponents() {
     }
 
     // Handle missing/custom materials
-    if (!mesh.MaterialGUID.empty() && currentIndex == 0) {
+    if (!mesh.MaterialGUID.IsEmpty() && currentIndex == 0) {
       bool found = false;
       for (int i = 0; i < materialCombo->count(); ++i) {
         if (materialCombo->itemData(i).toString().toStdString() ==
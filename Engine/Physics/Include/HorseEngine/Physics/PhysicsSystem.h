@@ -14,6 +14,14 @@ namespace Horse {
 
 class Scene;
 
+// Jolt's temporary memory, shared by every PhysicsSystem
+struct PhysicsTempMemoryStats {
+  size_t Budget = 0;
+  size_t StepHighWater = 0;     // Most in use during the last Step
+  size_t StepFallbackBytes = 0; // Allocated past the budget in that Step
+  size_t PeakHighWater = 0;     // Most in use during any Step
+};
+
 class PhysicsSystem {
 public:
   PhysicsSystem();
@@ -31,10 +39,15 @@ public:
   JPH::PhysicsSystem *GetJoltSystem() const { return m_JoltSystem; }
   JPH::BodyInterface *GetBodyInterface() const;
 
+  // Budget of the shared temp arena (10 MB by default); steps that need
+  // more fall back to the heap
+  static void SetTempMemoryBudget(size_t bytes);
+  static PhysicsTempMemoryStats GetTempMemoryStats();
+
 private:
   JPH::PhysicsSystem *m_JoltSystem = nullptr;
-  JPH::TempAllocator *m_TempAllocator = nullptr;
-  JPH::JobSystem *m_JobSystem = nullptr;
+  JPH::TempAllocator *m_TempAllocator = nullptr; // Shared, see above
+  JPH::JobSystem *m_JobSystem = nullptr; // Shared engine job system adapter
 
   // Jolt interfaces (stored as opaque pointers or simple internal classes if
   // defined in cpp) We'll define them in the cpp or use void* if we want to be
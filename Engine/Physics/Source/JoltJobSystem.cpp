@@ -0,0 +1,68 @@
+#include "JoltJobSystem.h"
+
+#include "HorseEngine/Core/JobSystem.h"
+
+#include <chrono>
+#include <thread>
+
+namespace Horse {
+
+JoltJobSystem::JoltJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers)
+    : JPH::JobSystemWithBarrier(maxBarriers) {
+  m_Jobs.Init(maxJobs, maxJobs);
+}
+
+int JoltJobSystem::GetMaxConcurrency() const {
+  // Workers plus the thread waiting on the barrier, which runs jobs too
+  return static_cast<int>(Horse::JobSystem::GetThreadCount()) + 1;
+}
+
+JPH::JobSystem::JobHandle
+JoltJobSystem::CreateJob(const char *inName, JPH::ColorArg inColor,
+                         const JobFunction &inJobFunction,
+                         JPH::uint32 inNumDependencies) {
+  JPH::uint32 index;
+  while (true) {
+    index = m_Jobs.ConstructObject(inName, inColor, this, inJobFunction,
+                                   inNumDependencies);
+    if (index != AvailableJobs::cInvalidObjectIndex) {
+      break;
+    }
+    JPH_ASSERT(false, "No Jolt jobs available!");
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  Job *job = &m_Jobs.Get(index);
+
+  // The handle keeps a reference; the job may complete as soon as it is
+  // queued
+  JobHandle handle(job);
+  if (inNumDependencies == 0) {
+    QueueJob(job);
+  }
+  return handle;
+}
+
+void JoltJobSystem::QueueJob(Job *inJob) {
+  // Without workers the barrier runs its jobs on the waiting thread
+  if (Horse::JobSystem::GetThreadCount() == 0) {
+    return;
+  }
+
+  // Physics steps inside the frame. Job::Execute is a no-op if the barrier
+  // already ran it.
+  inJob->AddRef();
+  Horse::JobSystem::Execute(JobPriority::FrameCritical, [inJob]() {
+    inJob->Execute();
+    inJob->Release();
+  });
+}
+
+void JoltJobSystem::QueueJobs(Job **inJobs, JPH::uint inNumJobs) {
+  for (JPH::uint i = 0; i < inNumJobs; ++i) {
+    QueueJob(inJobs[i]);
+  }
+}
+
+void JoltJobSystem::FreeJob(Job *inJob) { m_Jobs.DestructObject(inJob); }
+
+} // namespace Horse
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace Horse {
+
+// JPH::JobSystem on top of the engine JobSystem, so physics runs on the
+// same workers as everything else instead of bringing its own pool. Jolt's
+// job objects and barriers stay Jolt's; only the execution is handed over.
+class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+public:
+  JoltJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers);
+  ~JoltJobSystem() override = default;
+
+  int GetMaxConcurrency() const override;
+  JobHandle CreateJob(const char *inName, JPH::ColorArg inColor,
+                      const JobFunction &inJobFunction,
+                      JPH::uint32 inNumDependencies = 0) override;
+
+protected:
+  void QueueJob(Job *inJob) override;
+  void QueueJobs(Job **inJobs, JPH::uint inNumJobs) override;
+  void FreeJob(Job *inJob) override;
+
+private:
+  using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+  AvailableJobs m_Jobs;
+};
+
+} // namespace Horse
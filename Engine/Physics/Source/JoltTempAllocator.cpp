@@ -0,0 +1,65 @@
+#include "JoltTempAllocator.h"
+
+#include "HorseEngine/Core/MemoryTracker.h"
+
+#include <algorithm>
+
+namespace Horse {
+
+// Address space only; pages are committed as the arena is used, so the
+// budget can grow up to this without moving anything
+static constexpr size_t ArenaReserve = 256 * 1024 * 1024;
+
+JoltTempAllocator::JoltTempAllocator(size_t budget)
+    : m_Arena(std::max(budget, ArenaReserve)), m_Budget(budget) {
+  m_Blocks.reserve(64);
+}
+
+void *JoltTempAllocator::Allocate(JPH::uint inSize) {
+  if (inSize == 0) {
+    return nullptr;
+  }
+
+  const size_t size = JPH::AlignUp(inSize, JPH_RVECTOR_ALIGNMENT);
+  Block block{m_Arena.GetMarker(), nullptr, size};
+  void *ptr = nullptr;
+  if (m_Arena.GetUsed() + size <= m_Budget) {
+    ptr = m_Arena.Allocate(size, JPH_RVECTOR_ALIGNMENT);
+  }
+  if (!ptr) {
+    ptr = MemoryTracker::Allocate(size, MemoryTag::Physics,
+                                  JPH_RVECTOR_ALIGNMENT);
+    block.Heap = ptr;
+    m_HeapBytes += size;
+    m_StepFallbackBytes += size;
+  }
+  m_Blocks.push_back(block);
+
+  m_StepHighWater =
+      std::max(m_StepHighWater, m_Arena.GetUsed() + m_HeapBytes);
+  return ptr;
+}
+
+void JoltTempAllocator::Free(void *inAddress, JPH::uint inSize) {
+  if (!inAddress) {
+    JPH_ASSERT(inSize == 0);
+    return;
+  }
+
+  JPH_ASSERT(!m_Blocks.empty());
+  const Block block = m_Blocks.back();
+  m_Blocks.pop_back();
+  if (block.Heap) {
+    JPH_ASSERT(block.Heap == inAddress);
+    MemoryTracker::Free(block.Heap);
+    m_HeapBytes -= block.Size;
+  }
+  m_Arena.FreeToMarker(block.Marker);
+}
+
+void JoltTempAllocator::BeginStep() {
+  m_StepHighWater = m_Arena.GetUsed() + m_HeapBytes;
+  m_StepFallbackBytes = 0;
+}
+
+} // namespace Horse
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Core/TempAllocator.h>
+
+#include "HorseEngine/Core/Memory.h"
+
+#include <vector>
+
+namespace Horse {
+
+// JPH::TempAllocator on an engine stack arena shared by every
+// PhysicsSystem, instead of a fixed 10 MB block per scene. Jolt frees in
+// reverse order, so a step must hold it exclusively. Allocations past the
+// budget fall back to the heap rather than failing.
+class JoltTempAllocator final : public JPH::TempAllocator {
+public:
+  explicit JoltTempAllocator(size_t budget);
+
+  void *Allocate(JPH::uint inSize) override;
+  void Free(void *inAddress, JPH::uint inSize) override;
+
+  // The budget may change at any time; it applies to new allocations
+  void SetBudget(size_t budget) { m_Budget = budget; }
+  size_t GetBudget() const { return m_Budget; }
+
+  void BeginStep(); // Resets the per-step figures below
+  size_t GetStepHighWater() const { return m_StepHighWater; }
+  size_t GetStepFallbackBytes() const { return m_StepFallbackBytes; }
+
+private:
+  struct Block {
+    StackAllocator::Marker Marker;
+    void *Heap; // Set for fallback allocations
+    size_t Size;
+  };
+
+  StackAllocator m_Arena;
+  std::vector<Block> m_Blocks;
+  size_t m_Budget;
+  size_t m_HeapBytes = 0;
+  size_t m_StepHighWater = 0;
+  size_t m_StepFallbackBytes = 0;
+};
+
+} // namespace Horse
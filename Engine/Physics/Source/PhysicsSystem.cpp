@@ -1,14 +1,17 @@
 #include <Jolt/Jolt.h>
 
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/MemoryTracker.h"
+#include "JoltJobSystem.h"
+#include "JoltTempAllocator.h"
 #include "HorseEngine/Physics/PhysicsComponents.h"
 #include "HorseEngine/Physics/PhysicsSystem.h"
 #include "HorseEngine/Scene/Components.h"
 #include "HorseEngine/Scene/Entity.h"
+#include "HorseEngine/Scene/ParallelView.h"
 #include "HorseEngine/Scene/Scene.h"
 
 #include <Jolt/Core/Factory.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
@@ -20,7 +23,7 @@
 
 #include <cstdarg>
 #include <iostream>
-#include <thread>
+#include <mutex>
 
 // Jolt Callback Trace
 static void TraceImpl(const char *inFMT, ...) {
@@ -45,6 +48,25 @@ static bool AssertFailedImpl(const char *inExpression, const char *inMessage,
 };
 #endif
 
+// Jolt allocation hooks, charged to the Physics memory tag
+static void *JoltAllocate(size_t inSize) {
+  return Horse::MemoryTracker::Allocate(inSize, Horse::MemoryTag::Physics);
+}
+
+#if JPH_VERSION_MAJOR >= 5
+static void *JoltReallocate(void *inBlock, size_t, size_t inNewSize) {
+  return Horse::MemoryTracker::Reallocate(inBlock, inNewSize,
+                                          Horse::MemoryTag::Physics);
+}
+#endif
+
+static void *JoltAlignedAllocate(size_t inSize, size_t inAlignment) {
+  return Horse::MemoryTracker::Allocate(inSize, Horse::MemoryTag::Physics,
+                                        inAlignment);
+}
+
+static void JoltFree(void *inBlock) { Horse::MemoryTracker::Free(inBlock); }
+
 namespace Horse {
 
 // Layer constants
@@ -137,33 +159,76 @@ public:
   }
 };
 
-// PhysicsSystem Implementation
+// Jolt's globals (allocator hooks, factory, type registry), the job system
+// adapter and the temp allocator are shared by every PhysicsSystem, e.g.
+// the editor scene and its play-mode copy. The first user sets them up,
+// the last frees them.
+static std::mutex s_JoltMutex;
+static u32 s_JoltUsers = 0;
+static JoltJobSystem *s_JoltJobSystem = nullptr;
+static JoltTempAllocator *s_JoltTempAllocator = nullptr;
+
+// Held for a whole Step: the temp allocator is a stack
+static std::mutex s_JoltStepMutex;
+static size_t s_TempBudget = 10 * 1024 * 1024;
+static PhysicsTempMemoryStats s_TempStats;
+
+static JPH::JobSystem *AcquireJolt() {
+  std::lock_guard<std::mutex> lock(s_JoltMutex);
+  if (s_JoltUsers++ == 0) {
+    // Register allocation hooks
+    JPH::Allocate = JoltAllocate;
+#if JPH_VERSION_MAJOR >= 5
+    JPH::Reallocate = JoltReallocate;
+#endif
+    JPH::Free = JoltFree;
+    JPH::AlignedAllocate = JoltAlignedAllocate;
+    JPH::AlignedFree = JoltFree;
 
-PhysicsSystem::PhysicsSystem() {}
+    // Setup Trace and Assert
+    JPH::Trace = TraceImpl;
+#ifdef JPH_ENABLE_ASSERTS
+    JPH::AssertFailed = AssertFailedImpl;
+#endif
 
-PhysicsSystem::~PhysicsSystem() { Shutdown(); }
+    // Create factory
+    JPH::Factory::sInstance = new JPH::Factory();
 
-void PhysicsSystem::Initialize() {
-  // Register allocation hook
-  JPH::RegisterDefaultAllocator();
+    // Register standard types
+    JPH::RegisterTypes();
 
-  // Setup Trace and Assert
-  JPH::Trace = TraceImpl;
-#ifdef JPH_ENABLE_ASSERTS
-  JPH::AssertFailed = AssertFailedImpl;
-#endif
+    s_JoltJobSystem =
+        new JoltJobSystem(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+    s_JoltTempAllocator = new JoltTempAllocator(s_TempBudget);
+  }
+  return s_JoltJobSystem;
+}
+
+static void ReleaseJolt() {
+  std::lock_guard<std::mutex> lock(s_JoltMutex);
+  if (--s_JoltUsers > 0) {
+    return;
+  }
+
+  delete s_JoltJobSystem;
+  s_JoltJobSystem = nullptr;
+  delete s_JoltTempAllocator;
+  s_JoltTempAllocator = nullptr;
+
+  JPH::UnregisterTypes();
+  delete JPH::Factory::sInstance;
+  JPH::Factory::sInstance = nullptr;
+}
 
-  // Create factory
-  JPH::Factory::sInstance = new JPH::Factory();
+// PhysicsSystem Implementation
 
-  // Register standard types
-  JPH::RegisterTypes();
+PhysicsSystem::PhysicsSystem() {}
 
-  // Allocators
-  m_TempAllocator = new JPH::TempAllocatorImpl(10 * 1024 * 1024); // 10MB
-  m_JobSystem = new JPH::JobSystemThreadPool(
-      JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers,
-      std::thread::hardware_concurrency() - 1);
+PhysicsSystem::~PhysicsSystem() { Shutdown(); }
+
+void PhysicsSystem::Initialize() {
+  m_JobSystem = AcquireJolt();
+  m_TempAllocator = s_JoltTempAllocator;
 
   // Interfaces
   m_BPLayerInterface = new BPLayerInterfaceImpl();
@@ -199,22 +264,30 @@ void PhysicsSystem::Shutdown() {
     m_ObjectLayerPairFilter = nullptr;
   }
 
+  m_TempAllocator = nullptr;
+
   if (m_JobSystem) {
-    delete m_JobSystem;
     m_JobSystem = nullptr;
+    ReleaseJolt();
   }
-  if (m_TempAllocator) {
-    delete m_TempAllocator;
-    m_TempAllocator = nullptr;
-  }
+}
 
-  // Cleanup factory
-  if (JPH::Factory::sInstance) {
-    delete JPH::Factory::sInstance;
-    JPH::Factory::sInstance = nullptr;
+void PhysicsSystem::SetTempMemoryBudget(size_t bytes) {
+  std::lock_guard<std::mutex> joltLock(s_JoltMutex);
+  std::lock_guard<std::mutex> stepLock(s_JoltStepMutex);
+  s_TempBudget = bytes;
+  if (s_JoltTempAllocator) {
+    s_JoltTempAllocator->SetBudget(bytes);
   }
 }
 
+PhysicsTempMemoryStats PhysicsSystem::GetTempMemoryStats() {
+  std::lock_guard<std::mutex> lock(s_JoltStepMutex);
+  PhysicsTempMemoryStats stats = s_TempStats;
+  stats.Budget = s_TempBudget;
+  return stats;
+}
+
 JPH::BodyInterface *PhysicsSystem::GetBodyInterface() const {
   return m_JoltSystem ? &m_JoltSystem->GetBodyInterface() : nullptr;
 }
@@ -270,7 +343,7 @@ void PhysicsSystem::OnRuntimeStart(Scene *scene) {
       HORSE_LOG_CORE_WARN(
           "Entity '{}' has a RigidBody but no valid Collider (BoxCollider, "
           "etc.). Physics body will NOT be created.",
-          entity.GetComponent<TagComponent>().Name);
+          entity.GetComponent<TagComponent>().Name.GetString());
       continue;
     }
 
@@ -363,15 +436,38 @@ void PhysicsSystem::Step(float dt) {
 
   // Jolt Physics Step
   // cCollisionSteps = 1, cIntegrationSubSteps = 1 for now
-  m_JoltSystem->Update(dt, 1, m_TempAllocator, m_JobSystem);
+  {
+    std::lock_guard<std::mutex> lock(s_JoltStepMutex);
+    s_JoltTempAllocator->BeginStep();
+    m_JoltSystem->Update(dt, 1, m_TempAllocator, m_JobSystem);
+
+    const size_t highWater = s_JoltTempAllocator->GetStepHighWater();
+    const size_t fallback = s_JoltTempAllocator->GetStepFallbackBytes();
+    s_TempStats.StepHighWater = highWater;
+    s_TempStats.StepFallbackBytes = fallback;
+    if (highWater > s_TempStats.PeakHighWater) {
+      // Only new peaks are logged, so this stays quiet once warmed up
+      s_TempStats.PeakHighWater = highWater;
+      if (fallback > 0) {
+        HORSE_LOG_CORE_WARN("Physics temp memory: {} KB used, {} KB over the "
+                            "{} KB budget (heap fallback)",
+                            highWater / 1024, fallback / 1024,
+                            s_TempBudget / 1024);
+      } else {
+        HORSE_LOG_CORE_INFO("Physics temp memory high-water: {} KB of {} KB",
+                            highWater / 1024, s_TempBudget / 1024);
+      }
+    }
+  }
 
   // Sync back to transforms
   const float rad2deg = 180.0f / 3.14159f;
   auto &bodyInterface = m_JoltSystem->GetBodyInterface();
 
+  // Each body writes only its own components, so the sync runs in parallel
   auto view = m_ContextScene->GetRegistry()
                   .view<RigidBodyComponent, TransformComponent>();
-  for (auto e : view) {
+  ParallelForEach(view, [&](entt::entity e) {
     auto [rb, transform] = view.get<RigidBodyComponent, TransformComponent>(e);
 
     if (rb.RuntimeBody && !rb.Anchored) {
@@ -393,7 +489,7 @@ void PhysicsSystem::Step(float dt) {
         rb.AngularVelocity = {angVel.GetX(), angVel.GetY(), angVel.GetZ()};
       }
     }
-  }
+  });
 }
 
 } // namespace Horse
@@ -1,5 +1,7 @@
 #include "HorseEngine/Render/D3D11Renderer.h"
+#include "HorseEngine/Core/JobSystem.h"
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Memory.h"
 #include "HorseEngine/Render/D3D11Buffer.h"
 #include "HorseEngine/Render/D3D11Shader.h"
 #include "HorseEngine/Render/D3D11Texture.h"
@@ -19,6 +21,13 @@ using namespace DirectX;
 
 namespace Horse {
 
+// Material properties read for every draw
+static const StringId s_AlbedoName("Albedo");
+static const StringId s_AlbedoMapName("AlbedoMap");
+static const StringId s_RoughnessName("Roughness");
+static const StringId s_MetalnessName("Metalness");
+static const StringId s_DefaultMaterialName("Default");
+
 D3D11Renderer::D3D11Renderer() = default;
 
 D3D11Renderer::~D3D11Renderer() { Shutdown(); }
@@ -289,7 +298,7 @@ D3D11Renderer::GetShader(const std::string &shaderName,
   // Build Permutation Key & Defines
   // TODO: This mapping should ideally be data-driven or based on shader
   // metadata
-  if (material.HasTexture("AlbedoMap")) {
+  if (material.HasTexture(s_AlbedoMapName)) {
     key += "_ALBEDO";
     defines.push_back({"HAS_ALBEDO_MAP", "1"});
   }
@@ -429,15 +438,25 @@ void D3D11Renderer::RenderScene(Scene *scene, const XMMATRIX *overrideView,
   XMStoreFloat3(&cameraPos, cameraPosVec);
 
   // Cull and Collect
-  std::vector<RenderItem> renderItems;
+  // Candidates are culled in parallel; each writes only its own slot and
+  // invisible slots are compacted away afterwards. Both lists live in the
+  // render thread's scratch arena for the rest of this function.
+  ScratchScope scratch;
   auto meshView = registry.view<TransformComponent, MeshRendererComponent>();
-
+  ScratchVector<entt::entity> candidates;
+  candidates.reserve(meshView.size_hint());
   for (auto entity : meshView) {
     // Hidden From Player Camera Logic:
     // If this entity owns the current camera (i.e., is the Player Body), do not
     // render it.
-    if (entity == cameraOwner)
-      continue;
+    if (entity != cameraOwner)
+      candidates.push_back(entity);
+  }
+
+  ScratchVector<RenderItem> renderItems(candidates.size());
+  JobSystem::ParallelFor(0, static_cast<u32>(candidates.size()), 0, [&](u32 i) {
+    entt::entity entity = candidates[i];
+    renderItems[i] = {entity, -1.0f};
 
     auto [transform, mesh] =
         meshView.get<TransformComponent, MeshRendererComponent>(entity);
@@ -473,9 +492,15 @@ void D3D11Renderer::RenderScene(Scene *scene, const XMMATRIX *overrideView,
       float dz = transform.Position[2] - cameraPos.z;
       float distSq = dx * dx + dy * dy + dz * dz;
 
-      renderItems.push_back({entity, distSq});
+      renderItems[i].DistanceSq = distSq;
     }
-  }
+  });
+
+  renderItems.erase(std::remove_if(renderItems.begin(), renderItems.end(),
+                                   [](const RenderItem &item) {
+                                     return item.DistanceSq < 0.0f;
+                                   }),
+                    renderItems.end());
 
   // Draw Skybox Last (Background)
   // Only if we found a camera
@@ -531,7 +556,7 @@ void D3D11Renderer::RenderScene(Scene *scene, const XMMATRIX *overrideView,
     // Use Material Registry to get the material for this entity
     auto material = MaterialRegistry::Get().GetMaterial(mesh.MaterialGUID);
     if (!material) {
-      material = MaterialRegistry::Get().GetMaterial("Default");
+      material = MaterialRegistry::Get().GetMaterial(s_DefaultMaterialName);
     }
 
     // Bind Shader (Permutation Aware)
@@ -546,10 +571,10 @@ void D3D11Renderer::RenderScene(Scene *scene, const XMMATRIX *overrideView,
 
     // Update Material Constant Buffer
     MaterialConstantBuffer matCB;
-    auto color = material->GetColor("Albedo");
+    auto color = material->GetColor(s_AlbedoName);
     matCB.AlbedoColor = {color[0], color[1], color[2], color[3]};
-    matCB.Roughness = material->GetFloat("Roughness");
-    matCB.Metalness = material->GetFloat("Metalness");
+    matCB.Roughness = material->GetFloat(s_RoughnessName);
+    matCB.Metalness = material->GetFloat(s_MetalnessName);
     matCB.ViewMode = m_ViewMode;
 
     m_MaterialConstantBuffer->UpdateData(m_Context.Get(), &matCB,
@@ -559,7 +584,7 @@ void D3D11Renderer::RenderScene(Scene *scene, const XMMATRIX *overrideView,
 
     // Bind Textures
     // If material has an albedo texture, bind it. Else bind white texture.
-    std::string albedoPath = material->GetTexture("AlbedoMap");
+    std::string albedoPath = material->GetTexture(s_AlbedoMapName);
 
     // TODO: Texture Manager lookup. For now, just bind the white texture if
     // nothing else Or reuse the checkerboard if we want to visualize it
@@ -3,7 +3,6 @@
 #include "HorseEngine/Core/Logging.h"
 #include "HorseEngine/Project/Project.h"
 #include <filesystem>
-#include <fstream>
 #include <string>
 #include <vector>
 #include <windows.h>
@@ -20,13 +19,10 @@ bool D3D11Texture::LoadFromFile(ID3D11Device *device,
   namespace fs = std::filesystem;
   
   // Try loading through FileSystem (supports PAK files)
-  std::vector<uint8_t> fileData;
-  bool loaded = FileSystem::ReadBytes(filePath, fileData);
+  fs::path texturePath = filePath;
   
   // If FileSystem fails, try legacy path resolution for editor
-  if (!loaded) {
-    fs::path texturePath = filePath;
-    
+  if (!FileSystem::Exists(texturePath)) {
     // In editor mode, try project directory first
     if (texturePath.is_relative() && !Project::IsCooked()) {
       auto projectDir = Project::GetProjectDirectory();
@@ -70,24 +66,36 @@ bool D3D11Texture::LoadFromFile(ID3D11Device *device,
         }
       }
     }
-    
-    // Read file using standard filesystem
-    std::ifstream file(texturePath, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-      HORSE_LOG_RENDER_ERROR("Failed to open texture file: {}", texturePath.string());
-      return false;
-    }
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    fileData.resize(size);
-    file.read(reinterpret_cast<char*>(fileData.data()), size);
   }
 
   int width, height, channels;
   stbi_set_flip_vertically_on_load(true);
-  unsigned char *data =
-      stbi_load_from_memory(fileData.data(), static_cast<int>(fileData.size()), 
-                           &width, &height, &channels, 4);
+  unsigned char *data = nullptr;
+  if (FileSystem::CanMap(texturePath)) {
+    // Loose files and stored PAK entries: stb decodes straight from the
+    // mapping
+    MappedFile fileData = FileSystem::Map(texturePath);
+    if (!fileData) {
+      HORSE_LOG_RENDER_ERROR("Failed to open texture file: {}", texturePath.string());
+      return false;
+    }
+    data = stbi_load_from_memory(fileData.data(),
+                                 static_cast<int>(fileData.size()), &width,
+                                 &height, &channels, 4);
+  } else {
+    // Compressed entries are inflated chunk by chunk rather than into a
+    // copy of the whole file (PNG still gathers its IDAT data in one buffer)
+    std::unique_ptr<FileStream> stream = FileSystem::OpenStream(texturePath);
+    if (!stream) {
+      HORSE_LOG_RENDER_ERROR("Failed to open texture file: {}", texturePath.string());
+      return false;
+    }
+    const stbi_io_callbacks callbacks = {&FileStream::ReadCallback,
+                                         &FileStream::SkipCallback,
+                                         &FileStream::EofCallback};
+    data = stbi_load_from_callbacks(&callbacks, stream.get(), &width, &height,
+                                    &channels, 4);
+  }
 
   if (!data) {
     HORSE_LOG_RENDER_ERROR("Failed to decode texture: {}", filePath);
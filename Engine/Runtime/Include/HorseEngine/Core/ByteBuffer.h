@@ -0,0 +1,86 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include <cassert>
+#include <utility>
+
+namespace Horse {
+
+// Growable block of raw bytes for file contents, cooked data and
+// compression output. Unlike std::vector<u8>, resize() leaves new bytes
+// uninitialized, so a buffer that is about to be overwritten by a read or
+// a codec is not zeroed first.
+//
+// Once EnableLargePages() succeeded, buffers of at least LargePageThreshold
+// bytes are backed by large pages (2 MB on x64), which cuts TLB misses when
+// streaming through them. Falls back to the heap when the privilege or
+// contiguous physical memory is missing.
+class HORSE_API ByteBuffer {
+public:
+  static constexpr size_t LargePageThreshold = 4 * 1024 * 1024;
+
+  ByteBuffer() = default;
+  explicit ByteBuffer(size_t size) { resize(size); }
+  ByteBuffer(ByteBuffer &&other) noexcept
+      : m_Data(std::exchange(other.m_Data, nullptr)),
+        m_Size(std::exchange(other.m_Size, 0)),
+        m_Capacity(std::exchange(other.m_Capacity, 0)),
+        m_LargePages(std::exchange(other.m_LargePages, false)) {}
+  ByteBuffer &operator=(ByteBuffer &&other) noexcept {
+    if (this != &other) {
+      Release();
+      m_Data = std::exchange(other.m_Data, nullptr);
+      m_Size = std::exchange(other.m_Size, 0);
+      m_Capacity = std::exchange(other.m_Capacity, 0);
+      m_LargePages = std::exchange(other.m_LargePages, false);
+    }
+    return *this;
+  }
+  ByteBuffer(const ByteBuffer &) = delete;
+  ByteBuffer &operator=(const ByteBuffer &) = delete;
+  ~ByteBuffer() { Release(); }
+
+  u8 *data() { return m_Data; }
+  const u8 *data() const { return m_Data; }
+  size_t size() const { return m_Size; }
+  size_t capacity() const { return m_Capacity; }
+  bool empty() const { return m_Size == 0; }
+
+  u8 *begin() { return m_Data; }
+  u8 *end() { return m_Data + m_Size; }
+  const u8 *begin() const { return m_Data; }
+  const u8 *end() const { return m_Data + m_Size; }
+
+  u8 &operator[](size_t index) {
+    assert(index < m_Size);
+    return m_Data[index];
+  }
+  const u8 &operator[](size_t index) const {
+    assert(index < m_Size);
+    return m_Data[index];
+  }
+
+  // Keeps the first min(size, size()) bytes; anything past them is garbage
+  void resize(size_t size);
+  void reserve(size_t capacity);
+  // Drops the contents but keeps the memory
+  void clear() { m_Size = 0; }
+
+  bool IsLargePages() const { return m_LargePages; }
+
+  // Tries to acquire SeLockMemoryPrivilege, which large pages require. The
+  // account needs the "Lock pages in memory" right; returns false and keeps
+  // using regular pages otherwise. Call once at startup.
+  static bool EnableLargePages();
+  static bool IsLargePagesEnabled();
+
+private:
+  void Release();
+
+  u8 *m_Data = nullptr;
+  size_t m_Size = 0;
+  size_t m_Capacity = 0;
+  bool m_LargePages = false;
+};
+
+} // namespace Horse
@@ -1,12 +1,178 @@
 #pragma once
+#include <cstddef>
 #include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "HorseEngine/Core.h"
+#include "HorseEngine/Core/ByteBuffer.h"
+#include "HorseEngine/Core/JobSystem.h"
 
 namespace Horse {
 
+// Receives the file contents; 'data' is only valid during the call
+using FileReadCallback =
+    std::function<void(bool success, const ByteBuffer &data)>;
+using FileRequestID = u64;
+
+// Lookups of the path cache since startup, see FileSystem::GetPathCacheStats
+struct PathCacheStats {
+  u64 Hits = 0;
+  u64 Misses = 0;
+  size_t Entries = 0;
+};
+
+// Read-only view of a whole file, see FileSystem::Map. The bytes stay valid
+// for as long as the view or any copy of it is alive.
+class HORSE_API MappedFile {
+public:
+  MappedFile() = default;
+
+  const u8 *data() const { return m_Data; }
+  size_t size() const { return m_Size; }
+  bool empty() const { return m_Size == 0; }
+  const u8 *begin() const { return m_Data; }
+  const u8 *end() const { return m_Data + m_Size; }
+
+  std::span<const u8> GetBytes() const { return {m_Data, m_Size}; }
+  std::string_view GetText() const {
+    return {reinterpret_cast<const char *>(m_Data), m_Size};
+  }
+
+  // False if the file could not be opened; an empty file is still valid
+  bool IsValid() const { return m_Owner != nullptr; }
+  explicit operator bool() const { return IsValid(); }
+  // False if the bytes had to be copied, e.g. for a compressed PAK entry
+  bool IsMapped() const { return m_Mapped; }
+
+private:
+  friend class FileSystem;
+  friend class PakReader;
+
+  std::shared_ptr<const void> m_Owner; // Mapping or buffer holding the bytes
+  const u8 *m_Data = nullptr;
+  size_t m_Size = 0;
+  bool m_Mapped = false;
+};
+
+class FileStreamSource;
+
+// Sequential reader over a file, see FileSystem::OpenStream. At most three
+// chunks of the file are in memory: the current one, the one before it and
+// the next, which is read on the JobSystem's IO thread while the caller
+// parses the current one. If that thread has not started on it by the time
+// the caller needs it, the caller reads it itself rather than wait behind
+// other IO jobs. Seeking backwards is supported,
+// but costs a restart for compressed PAK entries.
+//
+// Not thread-safe; one stream is used by one thread at a time.
+class HORSE_API FileStream {
+public:
+  static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+  // Input iterator over the remaining bytes, for parsers that take an
+  // iterator pair (nlohmann::json::parse(stream.begin(), stream.end()))
+  class Iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char *;
+    using reference = const char &;
+
+    Iterator() = default;
+    explicit Iterator(FileStream *stream)
+        : m_Stream(stream && stream->Peek() ? stream : nullptr) {}
+
+    reference operator*() const {
+      return *reinterpret_cast<const char *>(m_Stream->m_Cursor);
+    }
+    Iterator &operator++() {
+      if (++m_Stream->m_Cursor == m_Stream->m_End && !m_Stream->Peek()) {
+        m_Stream = nullptr;
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    bool operator==(const Iterator &other) const {
+      return m_Stream == other.m_Stream;
+    }
+
+  private:
+    FileStream *m_Stream = nullptr; // Null at the end
+  };
+
+  FileStream(const FileStream &) = delete;
+  FileStream &operator=(const FileStream &) = delete;
+  ~FileStream();
+
+  u64 GetSize() const { return m_Size; }
+  u64 Tell() const { return m_ChunkOffset + (m_Cursor - m_Chunk.data()); }
+  bool IsEOF() const { return Tell() >= m_Size; }
+
+  // Copies up to 'size' bytes and returns how many were read; fewer only at
+  // the end of the file or on a read error
+  size_t Read(void *dest, size_t size);
+  // Returns the unread rest of the current chunk, reading the next one if
+  // it is used up, and moves past it. Empty at the end of the file. The
+  // bytes stay valid until the stream fetches two more chunks, so a parser
+  // can keep the previous chunk while it looks at the next.
+  std::span<const u8> ReadChunk();
+  // False if 'offset' is past the end of the file
+  bool Seek(u64 offset);
+  bool Skip(u64 count) { return Seek(Tell() + count); }
+
+  Iterator begin() { return Iterator(this); }
+  Iterator end() { return Iterator(); }
+
+  // Callbacks for decoders that pull their input, in the layout of
+  // stb_image's stbi_io_callbacks; 'user' is the FileStream. A negative
+  // skip moves back.
+  static int ReadCallback(void *user, char *data, int size);
+  static void SkipCallback(void *user, int n);
+  static int EofCallback(void *user);
+
+private:
+  friend class FileSystem;
+  friend class PakReader;
+
+  FileStream(std::unique_ptr<FileStreamSource> source, size_t chunkSize);
+
+  // Makes sure the cursor is on an unread byte; false at the end of the file
+  bool Peek() { return m_Cursor != m_End || Fill(); }
+  bool Fill();
+  void StartReadAhead();
+  // Waits for a read-ahead that is running, or drops one still queued
+  void FinishReadAhead();
+
+  std::unique_ptr<FileStreamSource> m_Source;
+  u64 m_Size = 0;
+  size_t m_ChunkSize = 0;
+
+  ByteBuffer m_Chunk;
+  ByteBuffer m_Previous; // Chunk before m_Chunk, see ReadChunk
+  u64 m_ChunkOffset = 0; // File offset of m_Chunk[0]
+  const u8 *m_Cursor = nullptr;
+  const u8 *m_End = nullptr;
+
+  // Next chunk, filled by a job on the IO thread
+  struct ReadAheadJob;
+  ByteBuffer m_Ahead;
+  u64 m_AheadOffset = 0;
+  size_t m_AheadSize = 0;
+  bool m_AheadReady = false;
+  std::shared_ptr<ReadAheadJob> m_AheadJob; // Null if none is queued
+};
+
 class HORSE_API FileSystem {
 public:
   static bool Initialize(const char *argv0);
@@ -14,15 +180,56 @@ public:
 
   static bool Mount(const std::string &archive, const std::string &mountPoint);
 
-  // Reads entire file into buffer
+  // Reads entire file into buffer; the buffer is not zeroed beforehand
   static bool ReadBytes(const std::filesystem::path &path,
-                        std::vector<uint8_t> &outData);
+                        ByteBuffer &outData);
 
   // Reads entire file into string
   static bool ReadText(const std::filesystem::path &path, std::string &outText);
 
+  // Maps the file into memory instead of copying it. Loose files and PAK
+  // entries stored without compression are mapped in place; compressed
+  // entries are decompressed into a buffer owned by the view.
+  static MappedFile Map(const std::filesystem::path &path);
+  // True if Map would view the file in place. If not, OpenStream keeps
+  // less of it in memory than Map.
+  static bool CanMap(const std::filesystem::path &path);
+
+  // Opens the file for chunked reads, so a large level or texture can be
+  // parsed without holding all of it in memory. Null if it does not exist.
+  static std::unique_ptr<FileStream>
+  OpenStream(const std::filesystem::path &path,
+             size_t chunkSize = FileStream::DefaultChunkSize);
+
+  // Starts the I/O threads serving ReadBytesAsync. Called by the engine
+  // right after JobSystem::Initialize.
+  static void StartAsyncIO(u32 threadCount = 2);
+  // Joins the I/O threads; reads still queued are dropped without a callback
+  static void StopAsyncIO();
+
+  // Reads the file on an I/O thread and calls 'callback' on the main thread
+  // from JobSystem::PumpMainThread, so the frame never waits on the disk.
+  // Requests for a path that is already queued or being read share that
+  // read. FrameCritical requests are served first, Background ones last.
+  // Without the I/O threads (tools) the file is read and the callback
+  // called before returning.
+  static FileRequestID ReadBytesAsync(const std::filesystem::path &path,
+                                      JobPriority priority,
+                                      FileReadCallback callback);
+  // Main thread only. Drops the callback if it has not run yet, and the read
+  // itself if it has not started and no other request shares it. Returns
+  // false if the callback already ran or the ID is unknown.
+  static bool CancelRead(FileRequestID request);
+
   static bool Exists(const std::filesystem::path &path);
 
+  // Where each path was found is cached, so Exists followed by a read
+  // resolves it once. Mount drops the whole cache; call this after creating
+  // or deleting files below a mounted directory while the game runs.
+  static void InvalidatePathCache();
+  static void InvalidatePathCache(const std::filesystem::path &path);
+  static PathCacheStats GetPathCacheStats();
+
   static std::vector<std::string>
   Enumerate(const std::filesystem::path &directory);
 };
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Horse {
+
+// Open-addressing hash map with linear probing. Entries live in one flat
+// array, so a lookup is a hash and a short scan instead of a pointer chase
+// through a bucket list. Erasing shifts the following entries back, so no
+// tombstones pile up.
+//
+// STL-style names so it drops in for std::unordered_map, but any insert
+// or erase invalidates iterators and references, and keys must not be
+// modified through an iterator.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using size_type = size_t;
+
+  template <bool Const> class Iterator {
+  public:
+    using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+    using Value = std::conditional_t<Const, const value_type, value_type>;
+
+    Iterator(Map *map, size_t index) : m_Map(map), m_Index(index) {
+      SkipEmpty();
+    }
+    operator Iterator<true>() const { return {m_Map, m_Index}; }
+
+    Value &operator*() const { return m_Map->m_Slots[m_Index]; }
+    Value *operator->() const { return &m_Map->m_Slots[m_Index]; }
+    Iterator &operator++() {
+      ++m_Index;
+      SkipEmpty();
+      return *this;
+    }
+    bool operator==(const Iterator &other) const {
+      return m_Index == other.m_Index;
+    }
+
+  private:
+    friend class FlatHashMap;
+
+    void SkipEmpty() {
+      while (m_Index < m_Map->m_Capacity && !m_Map->m_Used[m_Index]) {
+        ++m_Index;
+      }
+    }
+
+    Map *m_Map;
+    size_t m_Index;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatHashMap() = default;
+  explicit FlatHashMap(size_t capacity) { reserve(capacity); }
+  FlatHashMap(const FlatHashMap &other) {
+    reserve(other.size());
+    for (const value_type &entry : other) {
+      try_emplace(entry.first, entry.second);
+    }
+  }
+  FlatHashMap(FlatHashMap &&other) noexcept { Swap(other); }
+
+  FlatHashMap &operator=(const FlatHashMap &other) {
+    if (this != &other) {
+      FlatHashMap copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+  FlatHashMap &operator=(FlatHashMap &&other) noexcept {
+    if (this != &other) {
+      FlatHashMap moved(std::move(other));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  ~FlatHashMap() {
+    clear();
+    Release();
+  }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, m_Capacity}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, m_Capacity}; }
+
+  size_t size() const { return m_Size; }
+  bool empty() const { return m_Size == 0; }
+  size_t capacity() const { return m_Capacity; }
+
+  iterator find(const K &key) { return {this, FindIndex(key)}; }
+  const_iterator find(const K &key) const { return {this, FindIndex(key)}; }
+  bool contains(const K &key) const { return FindIndex(key) != m_Capacity; }
+  size_t count(const K &key) const { return contains(key) ? 1 : 0; }
+
+  V &operator[](const K &key) { return try_emplace(key).first->second; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    size_t index = FindIndex(key);
+    if (index != m_Capacity) {
+      return {{this, index}, false};
+    }
+
+    if ((m_Size + 1) * 8 > m_Capacity * MaxLoadEighths) {
+      Rehash(m_Capacity ? m_Capacity * 2 : MinCapacity);
+    }
+    index = HomeIndex(key);
+    while (m_Used[index]) {
+      index = (index + 1) & (m_Capacity - 1);
+    }
+    new (m_Slots + index) value_type(std::piecewise_construct,
+                                     std::forward_as_tuple(key),
+                                     std::forward_as_tuple(
+                                         std::forward<Args>(args)...));
+    m_Used[index] = 1;
+    ++m_Size;
+    return {{this, index}, true};
+  }
+  std::pair<iterator, bool> insert(const value_type &entry) {
+    return try_emplace(entry.first, entry.second);
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const K &key, M &&value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  size_t erase(const K &key) {
+    const size_t index = FindIndex(key);
+    if (index == m_Capacity) {
+      return 0;
+    }
+    EraseIndex(index);
+    return 1;
+  }
+  void erase(const_iterator pos) { EraseIndex(pos.m_Index); }
+
+  void clear() {
+    for (size_t i = 0; i < m_Capacity; ++i) {
+      if (m_Used[i]) {
+        m_Slots[i].~value_type();
+        m_Used[i] = 0;
+      }
+    }
+    m_Size = 0;
+  }
+
+  // Makes room for 'count' entries without rehashing
+  void reserve(size_t count) {
+    size_t capacity = MinCapacity;
+    while (capacity * MaxLoadEighths < count * 8) {
+      capacity *= 2;
+    }
+    if (capacity > m_Capacity) {
+      Rehash(capacity);
+    }
+  }
+
+private:
+  static constexpr size_t MinCapacity = 16;
+  static constexpr size_t MaxLoadEighths = 7;
+
+  // Fibonacci hashing spreads identity hashes (ints, UUIDs) over the table
+  size_t HomeIndex(const K &key) const {
+    const u64 hash = static_cast<u64>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> m_Shift);
+  }
+
+  size_t FindIndex(const K &key) const {
+    if (m_Size == 0) {
+      return m_Capacity;
+    }
+    for (size_t index = HomeIndex(key); m_Used[index];
+         index = (index + 1) & (m_Capacity - 1)) {
+      if (KeyEqual{}(m_Slots[index].first, key)) {
+        return index;
+      }
+    }
+    return m_Capacity;
+  }
+
+  // Backward-shift deletion: pulls later entries of the probe run into the
+  // hole unless that would move them in front of their home slot
+  void EraseIndex(size_t hole) {
+    assert(hole < m_Capacity && m_Used[hole]);
+    const size_t mask = m_Capacity - 1;
+    m_Slots[hole].~value_type();
+    m_Used[hole] = 0;
+    --m_Size;
+
+    for (size_t next = (hole + 1) & mask; m_Used[next];
+         next = (next + 1) & mask) {
+      const size_t home = HomeIndex(m_Slots[next].first);
+      // Distance travelled from home; the entry may only move back if the
+      // hole is within that distance
+      if (((next - home) & mask) < ((next - hole) & mask)) {
+        continue;
+      }
+      new (m_Slots + hole) value_type(std::move(m_Slots[next]));
+      m_Used[hole] = 1;
+      m_Slots[next].~value_type();
+      m_Used[next] = 0;
+      hole = next;
+    }
+  }
+
+  void Rehash(size_t capacity) {
+    value_type *slots = m_Slots;
+    u8 *used = m_Used;
+    const size_t oldCapacity = m_Capacity;
+
+    m_Slots = std::allocator<value_type>().allocate(capacity);
+    m_Used = new u8[capacity]();
+    m_Capacity = capacity;
+    m_Shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --m_Shift;
+    }
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+      if (!used[i]) {
+        continue;
+      }
+      size_t index = HomeIndex(slots[i].first);
+      while (m_Used[index]) {
+        index = (index + 1) & (m_Capacity - 1);
+      }
+      new (m_Slots + index) value_type(std::move(slots[i]));
+      m_Used[index] = 1;
+      slots[i].~value_type();
+    }
+
+    if (slots) {
+      std::allocator<value_type>().deallocate(slots, oldCapacity);
+      delete[] used;
+    }
+  }
+
+  void Release() {
+    if (m_Slots) {
+      std::allocator<value_type>().deallocate(m_Slots, m_Capacity);
+      delete[] m_Used;
+    }
+    m_Slots = nullptr;
+    m_Used = nullptr;
+    m_Capacity = 0;
+  }
+
+  void Swap(FlatHashMap &other) noexcept {
+    std::swap(m_Slots, other.m_Slots);
+    std::swap(m_Used, other.m_Used);
+    std::swap(m_Capacity, other.m_Capacity);
+    std::swap(m_Size, other.m_Size);
+    std::swap(m_Shift, other.m_Shift);
+  }
+
+  value_type *m_Slots = nullptr;
+  u8 *m_Used = nullptr;
+  size_t m_Capacity = 0; // Power of two
+  size_t m_Size = 0;
+  u32 m_Shift = 64;
+};
+
+} // namespace Horse
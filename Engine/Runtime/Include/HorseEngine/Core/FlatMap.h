@@ -0,0 +1,103 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Horse {
+
+// Map kept as a sorted vector of pairs. Lookups are a binary search over
+// contiguous memory and iteration is a linear walk, at the price of O(n)
+// inserts and erases. Meant for small maps that are built once and read
+// often, e.g. material properties.
+//
+// STL-style names so it drops in for std::map, but any insert or erase
+// invalidates iterators and references.
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using size_type = size_t;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  iterator begin() { return m_Entries.begin(); }
+  iterator end() { return m_Entries.end(); }
+  const_iterator begin() const { return m_Entries.begin(); }
+  const_iterator end() const { return m_Entries.end(); }
+
+  size_t size() const { return m_Entries.size(); }
+  bool empty() const { return m_Entries.empty(); }
+  void reserve(size_t count) { m_Entries.reserve(count); }
+  void clear() { m_Entries.clear(); }
+
+  iterator lower_bound(const K &key) {
+    return std::lower_bound(m_Entries.begin(), m_Entries.end(), key,
+                            KeyLess());
+  }
+  const_iterator lower_bound(const K &key) const {
+    return std::lower_bound(m_Entries.begin(), m_Entries.end(), key,
+                            KeyLess());
+  }
+
+  iterator find(const K &key) {
+    auto it = lower_bound(key);
+    return (it != end() && !Compare{}(key, it->first)) ? it : end();
+  }
+  const_iterator find(const K &key) const {
+    auto it = lower_bound(key);
+    return (it != end() && !Compare{}(key, it->first)) ? it : end();
+  }
+  bool contains(const K &key) const { return find(key) != end(); }
+  size_t count(const K &key) const { return contains(key) ? 1 : 0; }
+
+  V &operator[](const K &key) { return try_emplace(key).first->second; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    auto it = lower_bound(key);
+    if (it != end() && !Compare{}(key, it->first)) {
+      return {it, false};
+    }
+    it = m_Entries.emplace(it, std::piecewise_construct,
+                           std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    return {it, true};
+  }
+  std::pair<iterator, bool> insert(const value_type &entry) {
+    return try_emplace(entry.first, entry.second);
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const K &key, M &&value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  size_t erase(const K &key) {
+    auto it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    m_Entries.erase(it);
+    return 1;
+  }
+  iterator erase(const_iterator pos) { return m_Entries.erase(pos); }
+
+private:
+  struct KeyLess {
+    bool operator()(const value_type &entry, const K &key) const {
+      return Compare{}(entry.first, key);
+    }
+  };
+
+  std::vector<value_type> m_Entries;
+};
+
+} // namespace Horse
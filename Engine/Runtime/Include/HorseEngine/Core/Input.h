@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Core.h"
+#include "HorseEngine/Core/SmallVector.h"
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -69,15 +70,17 @@ enum KeyCode {
   KEY_Z
 };
 
+// Bindings rarely have more than a few keys; kept inline for the per-frame
+// IsActionPressed/GetAxisValue scans
 struct ActionMapping {
   std::string Name;
-  std::vector<int> Keys;
+  SmallVector<int, 4> Keys;
 };
 
 struct AxisMapping {
   std::string Name;
-  std::vector<int> PositiveKeys;
-  std::vector<int> NegativeKeys;
+  SmallVector<int, 4> PositiveKeys;
+  SmallVector<int, 4> NegativeKeys;
 };
 
 class HORSE_API Input {
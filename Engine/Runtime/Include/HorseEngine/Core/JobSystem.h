@@ -1,37 +1,289 @@
 #pragma once
 
 #include "HorseEngine/Core.h"
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <future>
+#include <initializer_list>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace Horse {
 
 using JobFunction = std::function<void()>;
+using JobRangeFunction = std::function<void(u32 first, u32 last)>;
+
+class JobCounter;
+
+// Where a job may run. Any jobs go to the worker pool; the others run only
+// on their own thread, for APIs that must always be called from the same
+// one (Lua state, PhysFS handles, the D3D11 immediate context).
+enum class JobAffinity : u8 {
+  Any,
+  Main,   // Thread that called JobSystem::Initialize, see PumpMainThread
+  IO,     // Dedicated file I/O thread
+  Script, // Dedicated scripting thread
+
+  Count
+};
+
+// Order in which workers pick up jobs without an affinity
+enum class JobPriority : u8 {
+  FrameCritical, // Needed to finish the current frame
+  Normal,
+  Background, // Only started while the frame is within its budget
+
+  Count
+};
+
+// Scheduling counters of one frame, see JobSystem::GetFrameStats
+struct JobFrameStats {
+  u32 FrameCriticalJobs = 0;
+  f64 FrameCriticalWaitTotal = 0.0; // Seconds spent queued, summed
+  f64 FrameCriticalWaitMax = 0.0;
+};
+
+// A queued job. Callables up to InlineSize bytes are stored in place, larger
+// ones fall back to a heap copy. Jobs are recycled through per-thread free
+// lists, so submitting a small job never touches the general-purpose heap.
+// InlineSize makes a whole Job exactly two cache lines on 64-bit targets.
+struct alignas(64) Job {
+  static constexpr size_t InlineSize = 80;
+  static constexpr size_t InlineAlign = 16;
+
+  alignas(InlineAlign) std::byte Storage[InlineSize];
+  void (*Invoke)(Job *job) = nullptr;
+  void (*Destroy)(Job *job) = nullptr;
+  JobCounter *Counter = nullptr;
+  f64 QueuedAt = 0.0; // Time::GetTime() when queued, frame-critical only
+  std::atomic<u32> PendingDependencies{0};
+  JobAffinity Affinity = JobAffinity::Any;
+  JobPriority Priority = JobPriority::Normal;
+  Job *Next = nullptr; // Free list link while pooled
+};
+
+// Tracks a group of jobs. Every job submitted with a counter increments it
+// and decrements it when it finishes, so a subsystem can wait on its own
+// batch without waiting for unrelated work. Counters can also be used as
+// prerequisites for other jobs. A counter must outlive the jobs using it.
+class HORSE_API JobCounter {
+public:
+  JobCounter() = default;
+  JobCounter(const JobCounter &) = delete;
+  JobCounter &operator=(const JobCounter &) = delete;
+
+  bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+  u32 GetPendingJobs() const { return m_Value.load(std::memory_order_acquire); }
+
+private:
+  friend class JobSystemImpl;
+
+  std::atomic<u32> m_Value{0};
+  std::mutex m_Mutex;
+  std::vector<Job *> m_Dependents; // Jobs waiting for this to hit zero
+};
+
+class JobSystem;
+class JobTask;
+template <typename T> struct JobResultAwaiter;
+
+// Result of a job started with JobSystem::ExecuteAsync(func, result). The
+// value is stored in this object, which the caller owns (usually on the
+// stack), so unlike std::future no shared state is allocated. It must
+// outlive the job.
+template <typename T> class JobResult {
+public:
+  JobResult() = default;
+  JobResult(const JobResult &) = delete;
+  JobResult &operator=(const JobResult &) = delete;
+
+  bool IsReady() const { return m_Counter.IsDone(); }
+
+  // Waits for the job, then returns its value or rethrows its exception
+  std::add_lvalue_reference_t<T> Get();
+
+private:
+  friend class JobSystem;
+  friend struct JobResultAwaiter<T>;
+
+  using Storage = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+  template <typename Func> void Run(Func &func) {
+    try {
+      if constexpr (std::is_void_v<T>) {
+        func();
+        m_Value.emplace();
+      } else {
+        m_Value.emplace(func());
+      }
+    } catch (...) {
+      m_Exception = std::current_exception();
+    }
+  }
+
+  JobCounter m_Counter;
+  std::optional<Storage> m_Value;
+  std::exception_ptr m_Exception;
+};
 
 class HORSE_API JobSystem {
 public:
   static void Initialize(u32 numThreads = 0); // 0 = auto-detect
   static void Shutdown();
 
-  static void Execute(JobFunction &&job);
+  // Adds the job to 'counter' (may be null). The job only becomes runnable
+  // once every counter in 'dependencies' has reached zero.
+  template <typename Func>
+  static void Execute(Func &&func, JobCounter *counter = nullptr,
+                      std::initializer_list<JobCounter *> dependencies = {}) {
+    Schedule(CreateJob(std::forward<Func>(func)), counter, dependencies);
+  }
+
+  template <typename Func>
+  static void Execute(JobPriority priority, Func &&func,
+                      JobCounter *counter = nullptr,
+                      std::initializer_list<JobCounter *> dependencies = {}) {
+    Job *job = CreateJob(std::forward<Func>(func));
+    job->Priority = priority;
+    Schedule(job, counter, dependencies);
+  }
+
+  // Same, but the job only runs on the thread owning 'affinity'
+  template <typename Func>
+  static void Execute(JobAffinity affinity, Func &&func,
+                      JobCounter *counter = nullptr,
+                      std::initializer_list<JobCounter *> dependencies = {}) {
+    Job *job = CreateJob(std::forward<Func>(func));
+    job->Affinity = affinity;
+    Schedule(job, counter, dependencies);
+  }
+
+  // Starts a coroutine job, see JobTask.h. It keeps its priority or
+  // affinity across suspensions until it moves itself with ResumeOn.
+  static void Execute(JobTask &&task, JobCounter *counter = nullptr,
+                      std::initializer_list<JobCounter *> dependencies = {});
+  static void Execute(JobPriority priority, JobTask &&task,
+                      JobCounter *counter = nullptr,
+                      std::initializer_list<JobCounter *> dependencies = {});
+  static void Execute(JobAffinity affinity, JobTask &&task,
+                      JobCounter *counter = nullptr,
+                      std::initializer_list<JobCounter *> dependencies = {});
 
   template <typename Func>
   static auto ExecuteAsync(Func &&func) -> std::future<decltype(func())> {
     using ReturnType = decltype(func());
-    auto task = std::make_shared<std::packaged_task<ReturnType()>>(
-        std::forward<Func>(func));
-    auto future = task->get_future();
+    std::packaged_task<ReturnType()> task(std::forward<Func>(func));
+    auto future = task.get_future();
 
-    Execute([task]() { (*task)(); });
+    Execute([task = std::move(task)]() mutable { task(); });
 
     return future;
   }
 
+  // Allocation-free variant: the result is written into 'result'
+  template <typename Func, typename T>
+  static void ExecuteAsync(Func &&func, JobResult<T> &result) {
+    result.m_Value.reset();
+    result.m_Exception = nullptr;
+    Execute([&result, func = std::forward<Func>(func)]() mutable {
+      result.Run(func);
+    }, &result.m_Counter);
+  }
+
+  // Runs fn(i) for every i in [begin, end), split into chunks of 'grain'
+  // items across the workers. The calling thread takes part. grain == 0
+  // times the first items and sizes chunks from the measured per-item cost,
+  // so cheap loops run inline instead of paying for scheduling.
+  template <typename Func>
+  static void ParallelFor(u32 begin, u32 end, u32 grain, Func &&fn) {
+    ParallelForRange(begin, end, grain, [&fn](u32 first, u32 last) {
+      for (u32 i = first; i < last; ++i) {
+        fn(i);
+      }
+    });
+  }
+
+  // Same as ParallelFor, but each call receives a whole chunk [first, last)
+  static void ParallelForRange(u32 begin, u32 end, u32 grain,
+                               const JobRangeFunction &fn);
+
+  // Marks the start of a frame for the background budget and rolls over the
+  // frame stats. Called by the engine loop; without it the budget is off.
+  static void BeginFrame();
+
+  // Background jobs are not started once the current frame has run for
+  // longer than this (seconds, measured with Time::GetTime). 0 = no limit.
+  static void SetFrameBudget(f64 seconds);
+  static f64 GetFrameBudget();
+  static bool IsOverFrameBudget();
+
+  // Counters of the last complete frame, main thread only
+  static JobFrameStats GetFrameStats();
+
+  // Runs the Main jobs queued so far. Called once per frame by the engine
+  // loop; jobs queued by these jobs wait for the next pump.
+  static void PumpMainThread();
+  static bool IsMainThread();
+
+  // Blocks until the counter reaches zero. Worker threads run other queued
+  // jobs while waiting; pinned threads (main, IO, script) run their own
+  // queue, so waiting on a job with the caller's affinity cannot deadlock.
+  static void Wait(JobCounter &counter);
   static void WaitAll();
   static u32 GetThreadCount();
 
 private:
+  template <typename Func> static Job *CreateJob(Func &&func) {
+    using Callable = std::decay_t<Func>;
+
+    Job *job = AllocateJob();
+    if constexpr (sizeof(Callable) <= Job::InlineSize &&
+                  alignof(Callable) <= Job::InlineAlign) {
+      ::new (job->Storage) Callable(std::forward<Func>(func));
+      job->Invoke = [](Job *self) {
+        (*std::launder(reinterpret_cast<Callable *>(self->Storage)))();
+      };
+      job->Destroy = [](Job *self) {
+        std::launder(reinterpret_cast<Callable *>(self->Storage))->~Callable();
+      };
+    } else {
+      ::new (job->Storage) Callable *(new Callable(std::forward<Func>(func)));
+      job->Invoke = [](Job *self) {
+        (**std::launder(reinterpret_cast<Callable **>(self->Storage)))();
+      };
+      job->Destroy = [](Job *self) {
+        delete *std::launder(reinterpret_cast<Callable **>(self->Storage));
+      };
+    }
+    return job;
+  }
+
+  static Job *AllocateJob();
+  static void Schedule(Job *job, JobCounter *counter,
+                       std::initializer_list<JobCounter *> dependencies);
+
   static class JobSystemImpl *s_Impl;
 };
 
+template <typename T> std::add_lvalue_reference_t<T> JobResult<T>::Get() {
+  JobSystem::Wait(m_Counter);
+  if (m_Exception) {
+    std::rethrow_exception(m_Exception);
+  }
+  if (!m_Value) {
+    // The job was dropped (job system not running)
+    throw std::future_error(std::future_errc::broken_promise);
+  }
+  if constexpr (!std::is_void_v<T>) {
+    return *m_Value;
+  }
+}
+
 } // namespace Horse
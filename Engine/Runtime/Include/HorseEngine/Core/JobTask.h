@@ -0,0 +1,163 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include "HorseEngine/Core/JobSystem.h"
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace Horse {
+
+// A job written as a C++20 coroutine. Instead of blocking its worker, it
+// can co_await a JobCounter, a JobResult, ResumeOn(affinity) or
+// YieldIfOverBudget(); the rest of the coroutine is then queued as a new
+// job once the wait is over, and the worker runs other jobs meanwhile.
+//
+//   JobTask LoadTexture(std::string path) {
+//     co_await ResumeOn(JobAffinity::IO);
+//     ByteBuffer bytes;
+//     FileSystem::ReadBytes(path, bytes);
+//     co_await ResumeOn(JobAffinity::Main);
+//     Upload(bytes);
+//   }
+//   JobSystem::Execute(LoadTexture("Textures/Grass.png"), &counter);
+//
+// The task counts as one job in its counter until the coroutine returns.
+class JobTask {
+public:
+  struct promise_type {
+    JobCounter *Counter = nullptr;
+    JobAffinity Affinity = JobAffinity::Any;
+    JobPriority Priority = JobPriority::Normal;
+
+    JobTask get_return_object() {
+      return JobTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  // Queues the rest of a suspended task with its affinity or priority, to
+  // run once 'dependency' (may be null) reaches zero
+  static void Continue(Handle coroutine, JobCounter *dependency);
+
+  // Job body that resumes a suspended task. Destroys the coroutine if the
+  // job is dropped without running.
+  struct Resumer {
+    Handle Coroutine;
+
+    explicit Resumer(Handle coroutine) : Coroutine(coroutine) {}
+    Resumer(Resumer &&other) noexcept
+        : Coroutine(std::exchange(other.Coroutine, {})) {}
+    Resumer(const Resumer &) = delete;
+    ~Resumer() {
+      if (Coroutine) {
+        Coroutine.destroy();
+      }
+    }
+
+    void operator()() { std::exchange(Coroutine, {}).resume(); }
+  };
+
+  JobTask(JobTask &&other) noexcept
+      : m_Coroutine(std::exchange(other.m_Coroutine, {})) {}
+  JobTask(const JobTask &) = delete;
+  JobTask &operator=(const JobTask &) = delete;
+  ~JobTask() {
+    if (m_Coroutine) {
+      m_Coroutine.destroy();
+    }
+  }
+
+  // Hands the coroutine over to the caller, used by JobSystem::Execute
+  Handle Release() { return std::exchange(m_Coroutine, {}); }
+
+private:
+  explicit JobTask(Handle coroutine) : m_Coroutine(coroutine) {}
+
+  Handle m_Coroutine;
+};
+
+inline void JobTask::Continue(Handle coroutine, JobCounter *dependency) {
+  promise_type &promise = coroutine.promise();
+  if (promise.Affinity != JobAffinity::Any) {
+    JobSystem::Execute(promise.Affinity, Resumer(coroutine), promise.Counter,
+                       {dependency});
+  } else {
+    JobSystem::Execute(promise.Priority, Resumer(coroutine), promise.Counter,
+                       {dependency});
+  }
+}
+
+// Continues the task once 'counter' reaches zero
+struct JobCounterAwaiter {
+  JobCounter &Counter;
+
+  bool await_ready() const {
+    if (!Counter.IsDone()) {
+      return false;
+    }
+    // Returns at once, but syncs with the thread that zeroed the counter so
+    // the task may destroy it
+    JobSystem::Wait(Counter);
+    return true;
+  }
+  void await_suspend(JobTask::Handle coroutine) {
+    JobTask::Continue(coroutine, &Counter);
+  }
+  void await_resume() const {}
+};
+
+inline JobCounterAwaiter operator co_await(JobCounter &counter) {
+  return {counter};
+}
+
+// Continues the task once the job behind 'result' finished; yields its value
+template <typename T> struct JobResultAwaiter {
+  JobResult<T> &Result;
+
+  bool await_ready() const { return Result.IsReady(); }
+  void await_suspend(JobTask::Handle coroutine) {
+    JobCounterAwaiter{Result.m_Counter}.await_suspend(coroutine);
+  }
+  std::add_lvalue_reference_t<T> await_resume() { return Result.Get(); }
+};
+
+template <typename T>
+JobResultAwaiter<T> operator co_await(JobResult<T> &result) {
+  return {result};
+}
+
+// Moves the rest of the task to another thread, e.g. to the IO thread for
+// a blocking read and back to Main to publish the result
+struct JobAffinityAwaiter {
+  JobAffinity Affinity;
+
+  bool await_ready() const { return false; }
+  void await_suspend(JobTask::Handle coroutine) {
+    coroutine.promise().Affinity = Affinity;
+    JobTask::Continue(coroutine, nullptr);
+  }
+  void await_resume() const {}
+};
+
+inline JobAffinityAwaiter ResumeOn(JobAffinity affinity) { return {affinity}; }
+
+// Time-slices a long background task: once the frame is over budget the
+// rest of the task is requeued and, at background priority, waits for the
+// next frame
+struct JobBudgetAwaiter {
+  bool await_ready() const { return !JobSystem::IsOverFrameBudget(); }
+  void await_suspend(JobTask::Handle coroutine) {
+    JobTask::Continue(coroutine, nullptr);
+  }
+  void await_resume() const {}
+};
+
+inline JobBudgetAwaiter YieldIfOverBudget() { return {}; }
+
+} // namespace Horse
@@ -1,29 +1,169 @@
 #pragma once
 
 #include "HorseEngine/Core.h"
+#include <atomic>
+#include <cassert>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
 
 namespace Horse {
 
+// General-purpose heap behind malloc and new: "mimalloc" in builds with
+// HORSE_USE_MIMALLOC, otherwise "CRT"
+HORSE_API const char *GetHeapName();
+
+// Where an allocator's memory comes from. Heap allocates and zeroes the
+// full capacity up front; Virtual only reserves address space and commits
+// pages as the allocator grows into them, so an arena sized for the worst
+// case costs nothing until it is used.
+enum class MemoryBacking : u8 { Heap, Virtual };
+
 // Linear allocator for sequential allocations (fast, no individual frees)
 class HORSE_API LinearAllocator {
 public:
-  explicit LinearAllocator(size_t capacity);
+  explicit LinearAllocator(size_t capacity,
+                           MemoryBacking backing = MemoryBacking::Heap);
   ~LinearAllocator();
 
   void *Allocate(size_t size, size_t alignment = 16);
+  // With Virtual backing, also decommits pages that went unused for a while
   void Reset();
 
   size_t GetUsed() const { return m_Offset; }
   size_t GetCapacity() const { return m_Capacity; }
+  size_t GetCommitted() const { return m_Committed; }
 
 private:
+  friend class StackAllocator;
+
   u8 *m_Buffer = nullptr;
   size_t m_Capacity = 0;
   size_t m_Offset = 0;
+  MemoryBacking m_Backing;
+
+  // Virtual backing: committed prefix and usage since the last trim
+  size_t m_Committed = 0;
+  size_t m_TrimPeak = 0;
+  u32 m_ResetsSinceTrim = 0;
+};
+
+// Linear allocator that also frees back to a marker, last in first out, for
+// nested temporary work: a loader can build temp arrays while its caller
+// still holds its own. Not thread-safe. Every marker must be freed, and in
+// order; debug builds assert otherwise.
+class HORSE_API StackAllocator {
+public:
+  struct Marker {
+    size_t Offset = 0;
+    u32 Depth = 0;
+  };
+
+  explicit StackAllocator(size_t capacity,
+                          MemoryBacking backing = MemoryBacking::Virtual);
+
+  void *Allocate(size_t size, size_t alignment = 16);
+  template <typename T> T *AllocateArray(size_t count) {
+    return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  Marker GetMarker();
+  void FreeToMarker(const Marker &marker);
+
+  size_t GetUsed() const { return m_Memory.GetUsed(); }
+  size_t GetCapacity() const { return m_Memory.GetCapacity(); }
+
+private:
+  LinearAllocator m_Memory;
+  u32 m_Depth = 0; // Markers handed out and not freed yet
+};
+
+// Frees everything allocated on 'stack' during the scope
+class StackScope {
+public:
+  explicit StackScope(StackAllocator &stack)
+      : m_Stack(stack), m_Marker(stack.GetMarker()) {}
+  ~StackScope() { m_Stack.FreeToMarker(m_Marker); }
+
+  StackScope(const StackScope &) = delete;
+  StackScope &operator=(const StackScope &) = delete;
+
+private:
+  StackAllocator &m_Stack;
+  StackAllocator::Marker m_Marker;
+};
+
+// Thread-safe linear allocator. Each thread reserves chunks from the shared
+// page with an atomic bump and then allocates from its chunk without any
+// synchronisation; large requests bump the page directly. A full page is
+// chained to a new one instead of failing. Pages are reserved address space
+// committed as they fill up, kept across Reset(), and trimmed when usage
+// stays low. Reset() must not race with Allocate().
+class HORSE_API ConcurrentLinearAllocator {
+public:
+  explicit ConcurrentLinearAllocator(size_t pageSize,
+                                     size_t chunkSize = 64 * 1024);
+  ~ConcurrentLinearAllocator();
+
+  ConcurrentLinearAllocator(const ConcurrentLinearAllocator &) = delete;
+  ConcurrentLinearAllocator &
+  operator=(const ConcurrentLinearAllocator &) = delete;
+
+  void *Allocate(size_t size, size_t alignment = 16);
+  void Reset();
+
+  // Bytes reserved since the last Reset (whole chunks for small requests)
+  size_t GetUsed() const { return m_Used.load(std::memory_order_relaxed); }
+  size_t GetLastUsed() const { return m_LastUsed; } // Before the last Reset
+  size_t GetPeakUsed() const { return m_PeakUsed; } // Highest at any Reset
+  size_t GetCapacity() const {
+    return m_Capacity.load(std::memory_order_relaxed);
+  }
+  size_t GetCommitted() const {
+    return m_Committed.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Page;
+
+  static Page *CreatePage(size_t capacity);
+  static void DestroyPage(Page *page);
+  void *AllocateShared(size_t size, size_t alignment);
+  bool Commit(Page *page, size_t end);
+  void Grow(Page *full, size_t size);
+  void Trim(size_t peak);
+
+  Page *m_First = nullptr;
+  std::atomic<Page *> m_Current{nullptr};
+  std::mutex m_GrowMutex;
+  size_t m_PageSize;
+  size_t m_ChunkSize;
+
+  // Unique per Reset, so threads can tell their cached chunk is stale
+  std::atomic<u64> m_Generation{0};
+
+  std::atomic<size_t> m_Used{0};
+  std::atomic<size_t> m_Capacity{0};
+  std::atomic<size_t> m_Committed{0};
+  size_t m_LastUsed = 0;
+  size_t m_PeakUsed = 0;
+  size_t m_TrimPeak = 0;
+  u32 m_ResetsSinceTrim = 0;
+};
+
+struct FrameAllocatorStats {
+  size_t Used = 0;          // This frame so far
+  size_t LastFrameUsed = 0; // Whole previous frame
+  size_t PeakFrameUsed = 0; // Largest frame since Initialize
+  size_t Capacity = 0;      // Including overflow pages
+  size_t Committed = 0;     // Physically backed part of Capacity
 };
 
-// Frame allocator - resets every frame for transient allocations
+// Frame allocator - resets every frame for transient allocations. Safe to
+// use from jobs that finish within the frame.
 class HORSE_API FrameAllocator {
 public:
   static void Initialize(size_t capacity = 16 * 1024 * 1024); // 16 MB default
@@ -32,8 +172,305 @@ public:
 
   static void *Allocate(size_t size, size_t alignment = 16);
 
+  static FrameAllocatorStats GetStats();
+
+private:
+  static std::unique_ptr<ConcurrentLinearAllocator> s_Allocator;
+};
+
+// N-buffered frame allocator: memory allocated during frame N stays valid
+// until the start of frame N + frameCount (N+2 by default). Data built at
+// the end of simulation can then be consumed by a pipelined render stage
+// in the next frame. Thread-safe, like FrameAllocator; buffers are reserved
+// address space, committed only as they fill.
+class HORSE_API BufferedFrameAllocator {
+public:
+  static void Initialize(size_t capacity = 16 * 1024 * 1024, // Per buffer
+                         u32 frameCount = 2);
+  static void Shutdown();
+  static void NextFrame(); // Call at frame start; recycles the oldest buffer
+
+  static void *Allocate(size_t size, size_t alignment = 16);
+
+  static u32 GetFrameCount() { return static_cast<u32>(s_Buffers.size()); }
+  static FrameAllocatorStats GetStats(); // Of the current frame's buffer
+
 private:
-  static std::unique_ptr<LinearAllocator> s_Allocator;
+  static std::vector<std::unique_ptr<ConcurrentLinearAllocator>> s_Buffers;
+  static u32 s_Current;
+};
+
+// Per-thread scratch arena for job bodies and other short-lived temporaries.
+// Every thread gets its own, so allocation is a lock-free pointer bump.
+// Memory is given back by a ScratchScope when a job or job group is done,
+// and all of it at the first allocation after NewFrame(). Blocks grow on
+// demand and are kept for reuse.
+class HORSE_API ScratchArena {
+public:
+  struct Block;
+
+  // Position in the arena to rewind to
+  struct Marker {
+    Block *Position = nullptr;
+    size_t Offset = 0;
+    u64 Frame = 0;
+  };
+
+  ~ScratchArena();
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+
+  // The calling thread's arena
+  static ScratchArena &Get();
+
+  // Marks the end of a frame; each thread drops the previous frame's
+  // scratch memory on its next allocation. Call at frame start.
+  static void NewFrame();
+
+  void *Allocate(size_t size, size_t alignment = 16);
+
+  Marker GetMarker();
+  void FreeToMarker(const Marker &marker);
+
+  size_t GetUsed() const;
+  size_t GetCapacity() const;
+
+private:
+  ScratchArena() = default;
+
+  void SyncFrame();
+  Block *NextBlock(size_t size, size_t alignment);
+
+  Block *m_First = nullptr;
+  Block *m_Current = nullptr;
+  u64 m_Frame = 0;
+};
+
+// Frees everything allocated on this thread's scratch arena during the
+// scope, e.g. around a job body or a ParallelFor
+class ScratchScope {
+public:
+  ScratchScope()
+      : m_Arena(ScratchArena::Get()), m_Marker(m_Arena.GetMarker()) {}
+  ~ScratchScope() { m_Arena.FreeToMarker(m_Marker); }
+
+  ScratchScope(const ScratchScope &) = delete;
+  ScratchScope &operator=(const ScratchScope &) = delete;
+
+private:
+  ScratchArena &m_Arena;
+  ScratchArena::Marker m_Marker;
+};
+
+// STL allocator on a ScratchArena (the calling thread's by default).
+// deallocate is a no-op; containers must not outlive the scope or frame
+// they were filled in, and must only grow on the arena's own thread.
+template <typename T> class ScratchAllocator {
+public:
+  using value_type = T;
+
+  ScratchAllocator() noexcept : m_Arena(&ScratchArena::Get()) {}
+  explicit ScratchAllocator(ScratchArena &arena) noexcept : m_Arena(&arena) {}
+  template <typename U>
+  ScratchAllocator(const ScratchAllocator<U> &other) noexcept
+      : m_Arena(other.GetArena()) {}
+
+  T *allocate(size_t count) {
+    void *ptr = m_Arena->Allocate(count * sizeof(T), alignof(T));
+    if (!ptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(ptr);
+  }
+  void deallocate(T *, size_t) noexcept {}
+
+  ScratchArena *GetArena() const noexcept { return m_Arena; }
+
+  template <typename U>
+  bool operator==(const ScratchAllocator<U> &other) const noexcept {
+    return m_Arena == other.GetArena();
+  }
+
+private:
+  ScratchArena *m_Arena;
+};
+
+template <typename T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+enum class PoolGrowth : u8 {
+  Fixed,    // A single block; allocation fails once it is full
+  Linear,   // Every new block has the initial number of slots
+  Geometric // Every new block is twice the previous one
+};
+
+// Pool of fixed-size slots for objects of type T, for types that are
+// created and destroyed often. Slots are carved from blocks that stay
+// around while the pool lives, and freed slots are reused first, so
+// steady-state churn never reaches malloc. Thread-safe. Debug builds fill
+// free slots with a pattern and check it on reuse to catch writes after
+// free.
+template <typename T> class PoolAllocator {
+public:
+  explicit PoolAllocator(size_t blockSlots = 64,
+                         PoolGrowth growth = PoolGrowth::Geometric)
+      : m_NextBlockSlots(blockSlots ? blockSlots : 1), m_Growth(growth) {}
+
+  // Blocks are leaked rather than freed under live objects, which can
+  // happen for shared pools torn down at exit
+  ~PoolAllocator() {
+    if (m_Live != 0) {
+      for (auto &block : m_Blocks) {
+        block.release();
+      }
+    }
+  }
+
+  PoolAllocator(const PoolAllocator &) = delete;
+  PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+  // The pool used by everything allocating T in this module
+  static PoolAllocator &Shared() {
+    static PoolAllocator s_Pool;
+    return s_Pool;
+  }
+
+  // Uninitialized storage for one T; nullptr once a Fixed pool is full
+  void *Allocate() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Slot *slot = m_FreeList;
+    if (slot) {
+      m_FreeList = slot->Next;
+#ifndef NDEBUG
+      const u8 *bytes = slot->Storage;
+      for (size_t i = sizeof(Slot *); i < sizeof(Slot); ++i) {
+        assert(bytes[i] == FreePattern && "Pool slot written after free");
+      }
+#endif
+    } else {
+      if (m_Bump == m_BumpEnd && !Grow()) {
+        return nullptr;
+      }
+      slot = m_Bump++;
+    }
+    ++m_Live;
+#ifndef NDEBUG
+    std::memset(slot, AllocatedPattern, sizeof(Slot));
+#endif
+    return slot;
+  }
+
+  void Free(void *ptr) {
+    if (!ptr) {
+      return;
+    }
+    Slot *slot = static_cast<Slot *>(ptr);
+#ifndef NDEBUG
+    std::memset(slot, FreePattern, sizeof(Slot));
+#endif
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    slot->Next = m_FreeList;
+    m_FreeList = slot;
+    --m_Live;
+  }
+
+  template <typename... Args> T *New(Args &&...args) {
+    void *ptr = Allocate();
+    if (!ptr) {
+      throw std::bad_alloc();
+    }
+    try {
+      return new (ptr) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Free(ptr);
+      throw;
+    }
+  }
+
+  void Delete(T *object) {
+    if (object) {
+      object->~T();
+      Free(object);
+    }
+  }
+
+  size_t GetLiveCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Live;
+  }
+  size_t GetCapacity() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Capacity;
+  }
+
+private:
+  union Slot {
+    Slot *Next;
+    alignas(T) u8 Storage[sizeof(T)];
+  };
+
+  static constexpr u8 AllocatedPattern = 0xCD;
+  static constexpr u8 FreePattern = 0xDD;
+
+  bool Grow() {
+    if (m_Growth == PoolGrowth::Fixed && !m_Blocks.empty()) {
+      return false;
+    }
+    const size_t count = m_NextBlockSlots;
+    m_Blocks.emplace_back(new Slot[count]);
+    m_Bump = m_Blocks.back().get();
+    m_BumpEnd = m_Bump + count;
+    m_Capacity += count;
+    if (m_Growth == PoolGrowth::Geometric) {
+      m_NextBlockSlots *= 2;
+    }
+    return true;
+  }
+
+  mutable std::mutex m_Mutex;
+  std::vector<std::unique_ptr<Slot[]>> m_Blocks;
+  Slot *m_FreeList = nullptr;
+  Slot *m_Bump = nullptr; // Never used slots of the newest block
+  Slot *m_BumpEnd = nullptr;
+  size_t m_NextBlockSlots;
+  PoolGrowth m_Growth;
+  size_t m_Live = 0;
+  size_t m_Capacity = 0;
+};
+
+// STL allocator drawing single objects from PoolAllocator<T>::Shared(),
+// e.g. for std::allocate_shared. Arrays go to the heap.
+template <typename T> class PoolStlAllocator {
+public:
+  using value_type = T;
+
+  PoolStlAllocator() noexcept = default;
+  template <typename U>
+  PoolStlAllocator(const PoolStlAllocator<U> &) noexcept {}
+
+  T *allocate(size_t count) {
+    if (count != 1) {
+      return std::allocator<T>().allocate(count);
+    }
+    void *ptr = PoolAllocator<T>::Shared().Allocate();
+    if (!ptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, size_t count) noexcept {
+    if (count != 1) {
+      std::allocator<T>().deallocate(ptr, count);
+    } else {
+      PoolAllocator<T>::Shared().Free(ptr);
+    }
+  }
+
+  template <typename U>
+  bool operator==(const PoolStlAllocator<U> &) const noexcept {
+    return true;
+  }
 };
 
 } // namespace Horse
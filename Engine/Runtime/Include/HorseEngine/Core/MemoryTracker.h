@@ -0,0 +1,40 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+
+namespace Horse {
+
+// Subsystem an allocation is charged to
+enum class MemoryTag : u8 { Core, Scene, Physics, Script, Asset, Render, Count };
+
+struct MemoryTagStats {
+  size_t LiveBytes = 0;
+  size_t PeakBytes = 0;
+  u64 LiveAllocations = 0;
+  u64 TotalAllocations = 0;
+};
+
+// Tagged heap allocations with per-tag live/peak accounting. Each block
+// carries a small header with its size and tag, so Free needs neither.
+// Jolt and Lua allocate through here; engine code can too where a
+// subsystem owns large or numerous blocks.
+class HORSE_API MemoryTracker {
+public:
+  static void *Allocate(size_t size, MemoryTag tag, size_t alignment = 16);
+  // 'alignment' must match the original allocation's
+  static void *Reallocate(void *ptr, size_t size, MemoryTag tag,
+                          size_t alignment = 16);
+  static void Free(void *ptr);
+
+  static MemoryTagStats GetStats(MemoryTag tag);
+  static const char *GetTagName(MemoryTag tag);
+
+  // Logs one line per tag
+  static void LogReport();
+
+  // Logs a report every 'seconds' from Update (0 disables, the default)
+  static void SetReportInterval(f64 seconds);
+  static void Update(); // Call once per frame
+};
+
+} // namespace Horse
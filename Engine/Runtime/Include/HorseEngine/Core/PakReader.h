@@ -0,0 +1,86 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include "HorseEngine/Core/ByteBuffer.h"
+#include "HorseEngine/Core/FileSystem.h"
+#include "HorseEngine/Core/FlatHashMap.h"
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Horse {
+
+class FileMapping;
+
+// One file inside a PAK
+struct PakEntry {
+  u64 NameHash = 0;     // HashString of the path inside the archive
+  u64 HeaderOffset = 0; // Local ZIP header in front of the data
+  u32 CompressedSize = 0;
+  u32 UncompressedSize = 0;
+  u32 NameOffset = 0; // Into the reader's name block
+  u16 NameLength = 0;
+  u16 Method = 0; // 0 = stored, 8 = deflate
+
+  bool IsStored() const { return Method == 0; }
+};
+
+// Reads the PAKs written by the Packager (ZIP archives) without PhysFS.
+// The archive is memory-mapped and its central directory, which sits in one
+// block at the end, becomes a table of contents sorted by name hash with a
+// hash index on top, so finding an entry is O(1). Stored entries are served
+// from the mapping; deflated ones are inflated with zlib, in parallel on
+// the JobSystem when read as a batch.
+//
+// All reads are const and safe from any thread.
+class HORSE_API PakReader {
+public:
+  // Null if the file is missing or not a valid archive
+  static std::unique_ptr<PakReader> Open(const std::filesystem::path &path);
+  ~PakReader();
+
+  // 'name' is the path inside the archive, with forward slashes
+  const PakEntry *FindEntry(std::string_view name) const;
+  bool Contains(std::string_view name) const {
+    return FindEntry(name) != nullptr;
+  }
+  std::string_view GetName(const PakEntry &entry) const {
+    return std::string_view(m_Names).substr(entry.NameOffset,
+                                            entry.NameLength);
+  }
+  std::span<const PakEntry> GetEntries() const { return m_Entries; }
+  const std::filesystem::path &GetPath() const { return m_Path; }
+
+  // Bytes as they are in the archive, i.e. still compressed for deflated
+  // entries. Empty if the entry points outside the archive.
+  std::span<const u8> GetRawBytes(const PakEntry &entry) const;
+
+  bool Read(const PakEntry &entry, ByteBuffer &outData) const;
+  // Stored entries become views into the archive mapping; deflated ones
+  // are inflated into a buffer owned by the view
+  MappedFile Map(const PakEntry &entry) const;
+  // Stored entries are copied out of the mapping chunk by chunk, deflated
+  // ones inflated as the stream is read. Null if the entry is corrupt.
+  std::unique_ptr<FileStream>
+  OpenStream(const PakEntry &entry,
+             size_t chunkSize = FileStream::DefaultChunkSize) const;
+
+  // Reads outData.size() entries, inflating them in parallel on the
+  // JobSystem. Returns false if any of them failed.
+  bool ReadBatch(std::span<const PakEntry *const> entries,
+                 std::span<ByteBuffer> outData) const;
+
+private:
+  PakReader() = default;
+
+  std::filesystem::path m_Path;
+  std::shared_ptr<FileMapping> m_Mapping;
+  std::vector<PakEntry> m_Entries; // Sorted by NameHash
+  FlatHashMap<u64, u32> m_Index;   // NameHash -> m_Entries index
+  std::string m_Names;
+};
+
+} // namespace Horse
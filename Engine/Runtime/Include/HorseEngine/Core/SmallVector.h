@@ -0,0 +1,186 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Horse {
+
+// Vector that keeps its first N elements inline and only moves to the heap
+// beyond that. For short lists that are read far more often than they
+// grow: no allocation, and the elements sit next to their owner.
+// STL-style names so it drops in for std::vector.
+template <typename T, size_t N> class SmallVector {
+  static_assert(N > 0, "Use std::vector for SmallVector<T, 0>");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  SmallVector() = default;
+  SmallVector(std::initializer_list<T> init) {
+    append(init.begin(), init.end());
+  }
+  template <typename InputIt> SmallVector(InputIt first, InputIt last) {
+    append(first, last);
+  }
+  SmallVector(const SmallVector &other) { append(other.begin(), other.end()); }
+  SmallVector(SmallVector &&other) noexcept { MoveFrom(other); }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      clear();
+      append(other.begin(), other.end());
+    }
+    return *this;
+  }
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this != &other) {
+      clear();
+      ReleaseHeap();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    clear();
+    ReleaseHeap();
+  }
+
+  T *data() { return m_Data; }
+  const T *data() const { return m_Data; }
+  size_t size() const { return m_Size; }
+  size_t capacity() const { return m_Capacity; }
+  bool empty() const { return m_Size == 0; }
+  // True while the elements still live in the inline buffer
+  bool is_inline() const { return m_Data == Inline(); }
+
+  iterator begin() { return m_Data; }
+  iterator end() { return m_Data + m_Size; }
+  const_iterator begin() const { return m_Data; }
+  const_iterator end() const { return m_Data + m_Size; }
+
+  T &operator[](size_t index) {
+    assert(index < m_Size);
+    return m_Data[index];
+  }
+  const T &operator[](size_t index) const {
+    assert(index < m_Size);
+    return m_Data[index];
+  }
+  T &front() { return (*this)[0]; }
+  const T &front() const { return (*this)[0]; }
+  T &back() { return (*this)[m_Size - 1]; }
+  const T &back() const { return (*this)[m_Size - 1]; }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (m_Size == m_Capacity) {
+      // Construct the new element first: args may point into the old buffer
+      const size_t capacity = m_Capacity * 2;
+      T *data = Allocate(capacity);
+      new (data + m_Size) T(std::forward<Args>(args)...);
+      Relocate(data, capacity);
+    } else {
+      new (m_Data + m_Size) T(std::forward<Args>(args)...);
+    }
+    return m_Data[m_Size++];
+  }
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() {
+    assert(m_Size > 0);
+    m_Data[--m_Size].~T();
+  }
+
+  // Keeps the order of the remaining elements
+  iterator erase(const_iterator pos) {
+    assert(pos >= begin() && pos < end());
+    T *it = m_Data + (pos - m_Data);
+    std::move(it + 1, end(), it);
+    pop_back();
+    return it;
+  }
+
+  template <typename InputIt> void append(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity > m_Capacity) {
+      Relocate(Allocate(capacity), capacity);
+    }
+  }
+
+  void resize(size_t size) {
+    reserve(size);
+    while (m_Size < size) {
+      new (m_Data + m_Size++) T();
+    }
+    while (m_Size > size) {
+      pop_back();
+    }
+  }
+
+  void clear() {
+    std::destroy(m_Data, m_Data + m_Size);
+    m_Size = 0;
+  }
+
+private:
+  T *Inline() { return reinterpret_cast<T *>(m_Inline); }
+  const T *Inline() const { return reinterpret_cast<const T *>(m_Inline); }
+
+  static T *Allocate(size_t capacity) {
+    return std::allocator<T>().allocate(capacity);
+  }
+
+  // Moves the elements into 'data' and makes it the buffer
+  void Relocate(T *data, size_t capacity) {
+    for (size_t i = 0; i < m_Size; ++i) {
+      new (data + i) T(std::move(m_Data[i]));
+      m_Data[i].~T();
+    }
+    ReleaseHeap();
+    m_Data = data;
+    m_Capacity = capacity;
+  }
+
+  void ReleaseHeap() {
+    if (!is_inline()) {
+      std::allocator<T>().deallocate(m_Data, m_Capacity);
+      m_Data = Inline();
+      m_Capacity = N;
+    }
+  }
+
+  // Expects this to be empty and inline
+  void MoveFrom(SmallVector &other) {
+    if (other.is_inline()) {
+      for (T &value : other) {
+        new (m_Data + m_Size++) T(std::move(value));
+      }
+      other.clear();
+    } else {
+      m_Data = std::exchange(other.m_Data, other.Inline());
+      m_Size = std::exchange(other.m_Size, 0);
+      m_Capacity = std::exchange(other.m_Capacity, N);
+    }
+  }
+
+  T *m_Data = Inline();
+  size_t m_Size = 0;
+  size_t m_Capacity = N;
+  alignas(T) unsigned char m_Inline[sizeof(T) * N];
+};
+
+} // namespace Horse
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Horse {
+
+// 64-bit FNV-1a; constexpr so names known at compile time cost nothing
+constexpr u64 HashString(std::string_view str) {
+  u64 hash = 14695981039346656037ull;
+  for (char c : str) {
+    hash ^= static_cast<u8>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Interned string. Every distinct string is stored once in a global pool
+// and identified by its 64-bit hash, so copying, comparing and hashing a
+// StringId are integer operations. Collisions are caught when interning.
+//
+//   static const StringId s_Albedo("Albedo");
+//   material->GetColor(s_Albedo);
+//
+// Comparing against a plain string hashes it without touching the pool.
+class HORSE_API StringId {
+public:
+  StringId() = default;
+  StringId(std::string_view str);
+  StringId(const char *str) : StringId(std::string_view(str)) {}
+  StringId(const std::string &str) : StringId(std::string_view(str)) {}
+
+  u64 GetHash() const { return m_Hash; }
+  const std::string &GetString() const {
+    return m_String ? *m_String : s_Empty;
+  }
+  const char *c_str() const { return GetString().c_str(); }
+  bool IsEmpty() const { return m_String == nullptr; }
+
+  operator const std::string &() const { return GetString(); }
+
+  bool operator==(const StringId &other) const {
+    return m_Hash == other.m_Hash;
+  }
+  bool operator==(std::string_view str) const {
+    return m_Hash == HashString(str);
+  }
+  bool operator==(const char *str) const {
+    return m_Hash == HashString(str);
+  }
+  bool operator==(const std::string &str) const {
+    return m_Hash == HashString(str);
+  }
+  // Orders by hash, not alphabetically; enough for sorted containers
+  bool operator<(const StringId &other) const { return m_Hash < other.m_Hash; }
+
+  // Number of distinct strings interned so far
+  static size_t GetPoolSize();
+
+private:
+  static const std::string s_Empty;
+
+  u64 m_Hash = HashString({});
+  const std::string *m_String = nullptr;
+};
+
+} // namespace Horse
+
+namespace std {
+template <> struct hash<Horse::StringId> {
+  size_t operator()(const Horse::StringId &id) const {
+    return static_cast<size_t>(id.GetHash());
+  }
+};
+} // namespace std
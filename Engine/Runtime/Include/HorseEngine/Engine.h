@@ -28,6 +28,8 @@ public:
 
   void Run();
   void RunFrame();
+  // Ends Run after the current frame
+  void RequestExit() { m_Running = false; }
 
   Window *GetWindow() const { return m_Window.get(); }
   GameModule *GetGameModule() const;
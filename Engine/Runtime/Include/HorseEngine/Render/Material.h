@@ -1,10 +1,11 @@
 #pragma once
 
 #include "HorseEngine/Core.h"
+#include "HorseEngine/Core/FlatMap.h"
+#include "HorseEngine/Core/StringId.h"
 #include <array>
 #include <memory>
 #include <string>
-#include <unordered_map>
 
 namespace Horse {
 
@@ -21,30 +22,29 @@ public:
     m_ShaderName = shaderName;
   }
 
-  // Property Getters/Setters
-  void SetFloat(const std::string &name, float value);
-  float GetFloat(const std::string &name) const;
+  // Property Getters/Setters. Properties are keyed by interned name; hot
+  // paths should keep a static StringId rather than pass a literal.
+  void SetFloat(const StringId &name, float value);
+  float GetFloat(const StringId &name) const;
 
-  void SetColor(const std::string &name, const std::array<float, 4> &value);
-  std::array<float, 4> GetColor(const std::string &name) const;
+  void SetColor(const StringId &name, const std::array<float, 4> &value);
+  std::array<float, 4> GetColor(const StringId &name) const;
 
-  void SetTexture(const std::string &name, const std::string &pathOrAssetID);
-  std::string GetTexture(const std::string &name) const;
-  bool HasTexture(const std::string &name) const;
+  void SetTexture(const StringId &name, const std::string &pathOrAssetID);
+  std::string GetTexture(const StringId &name) const;
+  bool HasTexture(const StringId &name) const;
 
   const std::string &GetFilePath() const { return m_FilePath; }
   void SetFilePath(const std::string &path) { m_FilePath = path; }
 
   // Access to raw maps for serialization/iteration
-  const std::unordered_map<std::string, float> &GetFloatProperties() const {
+  const FlatMap<StringId, float> &GetFloatProperties() const {
     return m_FloatProps;
   }
-  const std::unordered_map<std::string, std::array<float, 4>> &
-  GetColorProperties() const {
+  const FlatMap<StringId, std::array<float, 4>> &GetColorProperties() const {
     return m_ColorProps;
   }
-  const std::unordered_map<std::string, std::string> &
-  GetTextureProperties() const {
+  const FlatMap<StringId, std::string> &GetTextureProperties() const {
     return m_TextureProps;
   }
 
@@ -53,9 +53,10 @@ private:
   std::string m_FilePath;
   std::string m_ShaderName;
 
-  std::unordered_map<std::string, float> m_FloatProps;
-  std::unordered_map<std::string, std::array<float, 4>> m_ColorProps;
-  std::unordered_map<std::string, std::string> m_TextureProps;
+  // A handful of entries each, read for every draw
+  FlatMap<StringId, float> m_FloatProps;
+  FlatMap<StringId, std::array<float, 4>> m_ColorProps;
+  FlatMap<StringId, std::string> m_TextureProps;
 };
 
 } // namespace Horse
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HorseEngine/Core.h"
+#include "HorseEngine/Core/StringId.h"
 #include "HorseEngine/Render/Material.h"
 #include <memory>
 #include <string>
@@ -12,7 +13,8 @@ class HORSE_API MaterialRegistry {
 public:
   static MaterialRegistry &Get();
 
-  std::shared_ptr<MaterialInstance> GetMaterial(const std::string &name);
+  // Looked up by interned name, so the per-frame path is an integer hash
+  std::shared_ptr<MaterialInstance> GetMaterial(const StringId &name);
   std::shared_ptr<MaterialInstance> CreateMaterial(const std::string &name);
 
   // Load a single material file
@@ -20,7 +22,7 @@ public:
   // Scan a directory recursively for .horsemat files
   void LoadMaterialsFromDirectory(const std::string &directory);
 
-  const std::unordered_map<std::string, std::shared_ptr<MaterialInstance>> &
+  const std::unordered_map<StringId, std::shared_ptr<MaterialInstance>> &
   GetMaterials() const {
     return m_Materials;
   }
@@ -29,8 +31,7 @@ private:
   MaterialRegistry();
   ~MaterialRegistry() = default;
 
-  std::unordered_map<std::string, std::shared_ptr<MaterialInstance>>
-      m_Materials;
+  std::unordered_map<StringId, std::shared_ptr<MaterialInstance>> m_Materials;
 };
 
 } // namespace Horse
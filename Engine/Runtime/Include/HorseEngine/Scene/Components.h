@@ -4,6 +4,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Memory.h"
+#include "HorseEngine/Core/StringId.h"
 #include "HorseEngine/Physics/PhysicsComponents.h"
 #include "HorseEngine/Scene/UUID.h"
 #include <array>
@@ -23,11 +25,11 @@ struct UUIDComponent {
 };
 
 struct TagComponent {
-  std::string Name = "Entity";
-  std::string Tag = "Default";
+  StringId Name = "Entity";
+  StringId Tag = "Default";
 
   TagComponent() = default;
-  TagComponent(const std::string &name) : Name(name) {}
+  TagComponent(const StringId &name) : Name(name) {}
 };
 
 struct TransformComponent {
@@ -75,8 +77,8 @@ struct LightComponent {
 };
 
 struct MeshRendererComponent {
-  std::string MeshGUID;
-  std::string MaterialGUID;
+  StringId MeshGUID;
+  StringId MaterialGUID;
 
   MeshRendererComponent() = default;
 };
@@ -100,11 +102,13 @@ struct NativeScriptComponent {
   void (*DestroyScript)(NativeScriptComponent *);
 
   template <typename T> void Bind() {
+    // Instances come from a per-type pool, so spawning and despawning
+    // scripted entities reuses memory
     InstantiateScript = []() {
-      return static_cast<ScriptableEntity *>(new T());
+      return static_cast<ScriptableEntity *>(PoolAllocator<T>::Shared().New());
     };
     DestroyScript = [](NativeScriptComponent *nsc) {
-      delete nsc->Instance;
+      PoolAllocator<T>::Shared().Delete(static_cast<T *>(nsc->Instance));
       nsc->Instance = nullptr;
     };
   }
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+#include "HorseEngine/Core/JobSystem.h"
+#include "HorseEngine/Core/Memory.h"
+#include <entt/entt.hpp>
+
+namespace Horse {
+
+// Runs fn(entity) for every entity of an EnTT view or component storage,
+// spread across the job system workers. Entities are gathered in storage
+// order first (in the calling thread's scratch arena), so each chunk walks
+// a contiguous run of component memory.
+// fn must only touch the components of the entity it is given (or other
+// read-only data); the registry itself must not be modified meanwhile.
+template <typename View, typename Func>
+void ParallelForEach(const View &view, Func &&fn, u32 grain = 0) {
+  ScratchScope scratch;
+  ScratchVector<entt::entity> entities;
+  if constexpr (requires { view.size_hint(); }) {
+    entities.reserve(view.size_hint());
+  } else {
+    entities.reserve(view.size());
+  }
+
+  for (auto entity : view) {
+    entities.push_back(entity);
+  }
+
+  JobSystem::ParallelFor(
+      0, static_cast<u32>(entities.size()), grain,
+      [&entities, &fn](u32 index) { fn(entities[index]); });
+}
+
+} // namespace Horse
@@ -1,13 +1,15 @@
 #pragma once
 
 #include "HorseEngine/Core.h"
+#include "HorseEngine/Core/FlatHashMap.h"
+#include "HorseEngine/Core/StringId.h"
 #include "HorseEngine/Scene/Entity.h"
 #include "HorseEngine/Scene/UUID.h"
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace Horse {
 
@@ -35,7 +37,7 @@ public:
   void DestroyEntity(Entity entity);
 
   Entity GetEntityByUUID(UUID uuid);
-  Entity GetEntityByName(const std::string &name);
+  Entity GetEntityByName(const StringId &name);
 
   const std::string &GetName() const { return m_Name; }
   void SetName(const std::string &name) { m_Name = name; }
@@ -63,10 +65,10 @@ private:
 private:
   std::string m_Name;
   entt::registry m_Registry;
-  std::unordered_map<UUID, entt::entity> m_EntityMap;
+  FlatHashMap<UUID, entt::entity> m_EntityMap;
   SceneState m_State = SceneState::Edit;
   LoadingStage m_LoadingStage = LoadingStage::None;
-  std::vector<std::string> m_LoadingQueue;
+  std::vector<StringId> m_LoadingQueue;
 
   // Physics
   PhysicsSystem *m_PhysicsSystem = nullptr;
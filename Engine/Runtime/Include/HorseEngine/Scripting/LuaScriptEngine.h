@@ -1,9 +1,12 @@
 #pragma once
 
 #include "HorseEngine/Core.h"
+#include "HorseEngine/Core/FileSystem.h"
 #include "HorseEngine/Scene/Entity.h"
+#include <filesystem>
 #include <sol/sol.hpp>
 #include <string>
+#include <string_view>
 
 namespace Horse {
 
@@ -12,9 +15,13 @@ public:
   static void Init();
   static void Shutdown();
 
+  // Starts loading the entity's script on the I/O threads; it runs and
+  // OnCreate is called from JobSystem::PumpMainThread once the file is in
   static void OnCreateEntity(Entity entity);
   static void OnUpdateEntity(Entity entity, float deltaTime);
   static void OnDestroyEntity(Entity entity);
+  // Drops script loads still pending for the scene's entities
+  static void OnDestroyScene(Scene *scene);
 
   static sol::state &GetState() { return *s_LuaState; }
 
@@ -23,9 +30,19 @@ private:
   static void BindLogging();
   static void BindInput();
 
+  static void RunScript(Entity entity, const std::filesystem::path &path,
+                        std::string_view source);
+
 private:
+  struct PendingScript {
+    Scene *Owner = nullptr;
+    std::filesystem::path Path;
+    FileRequestID Request = 0;
+  };
+
   static sol::state *s_LuaState;
   static std::unordered_map<UUID, sol::table> s_ScriptInstances;
+  static std::unordered_map<UUID, PendingScript> s_PendingScripts;
 };
 
 } // namespace Horse
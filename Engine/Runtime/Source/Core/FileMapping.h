@@ -0,0 +1,26 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+
+#include <filesystem>
+#include <memory>
+
+namespace Horse {
+
+// Whole file mapped read-only, shared by every view into it (FileSystem::Map,
+// PakReader entries). Implemented in FileSystem.cpp.
+class FileMapping {
+public:
+  // Null if the file cannot be opened or mapped; empty files map to nothing
+  static std::shared_ptr<FileMapping> Open(const std::filesystem::path &path);
+  ~FileMapping();
+
+  const u8 *GetData() const { return m_View; }
+  size_t GetSize() const { return m_Size; }
+
+private:
+  const u8 *m_View = nullptr;
+  size_t m_Size = 0;
+};
+
+} // namespace Horse
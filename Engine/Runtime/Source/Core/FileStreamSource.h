@@ -0,0 +1,25 @@
+#pragma once
+
+#include "HorseEngine/Core.h"
+
+namespace Horse {
+
+// Where a FileStream gets its bytes: a loose file, a PhysFS handle or a PAK
+// entry. Implemented next to each backend (FileSystem.cpp, PakReader.cpp).
+// The stream never calls it from two threads at once.
+class FileStreamSource {
+public:
+  explicit FileStreamSource(u64 size) : m_Size(size) {}
+  virtual ~FileStreamSource() = default;
+
+  u64 GetSize() const { return m_Size; }
+
+  // Reads up to 'size' bytes at 'offset' and returns how many were read;
+  // 0 at the end of the file or on an error
+  virtual size_t Read(u64 offset, u8 *dest, size_t size) = 0;
+
+private:
+  u64 m_Size = 0;
+};
+
+} // namespace Horse
@@ -1,18 +1,210 @@
 #include "HorseEngine/Core/FileSystem.h"
+#include "FileMapping.h"
+#include "FileStreamSource.h"
+#include "HorseEngine/Core/FlatHashMap.h"
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/PakReader.h"
+#include "HorseEngine/Core/StringId.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <physfs.h>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <Windows.h>
 
 namespace Horse {
 
 static bool s_Initialized = false;
 
-static void CanonicalizePhysFSPath(std::string &path) {
-  std::replace(path.begin(), path.end(), '\\', '/');
-  while (path.size() >= 2 && path[0] == '.' && path[1] == '/') {
-    path = path.substr(2);
+// Forward slashes and no leading "./", as PhysFS expects
+static std::string NormalizePath(const std::filesystem::path &path) {
+  std::string result = path.string();
+  std::replace(result.begin(), result.end(), '\\', '/');
+  size_t start = 0;
+  while (result.size() - start >= 2 && result[start] == '.' &&
+         result[start + 1] == '/') {
+    start += 2;
+  }
+  result.erase(0, start);
+  return result;
+}
+
+// PAKs mounted with FileSystem::Mount, searched in mount order after the
+// PhysFS search path. Only Shutdown removes them.
+struct PakMount {
+  std::string MountPoint; // Normalized, empty or ending in '/'
+  std::unique_ptr<PakReader> Reader;
+};
+
+// Every mount point, PhysFS and PAK, normalized like PakMount::MountPoint
+static std::shared_mutex s_MountMutex;
+static std::vector<PakMount> s_PakMounts;
+static std::vector<std::string> s_MountPoints;
+
+// Empty for the root, otherwise no leading and one trailing '/'
+static std::string NormalizeMountPoint(const std::string &mountPoint) {
+  std::string result = NormalizePath(mountPoint);
+  result.erase(0, result.find_first_not_of('/'));
+  if (!result.empty() && result.back() != '/') {
+    result += '/';
+  }
+  return result;
+}
+
+// Whether 'name' would be looked up in a mount. Absolute paths never are.
+static bool IsBelowMountPoint(const std::filesystem::path &path,
+                              std::string_view name) {
+  if (path.has_root_path())
+    return false;
+  std::shared_lock lock(s_MountMutex);
+  return std::any_of(s_MountPoints.begin(), s_MountPoints.end(),
+                     [name](const std::string &mountPoint) {
+                       return name.starts_with(mountPoint);
+                     });
+}
+
+// Where a path was last found, keyed by its interned normalized form.
+// Mounted content only changes on Mount, so answers for names below a mount
+// point, misses included, hold until the next one. Outside mounts only hits
+// are kept, since tools and the editor create files at any time; a failed
+// open drops a stale hit.
+enum class PathLocation : u8 { Missing, PhysFS, Pak, Native };
+
+struct PathEntry {
+  PathLocation Location = PathLocation::Missing;
+  StringId RealDir; // Directory or archive holding a PhysFS file
+  bool InArchive = false;
+  const PakReader *Pak = nullptr; // Mounted PAK holding the file
+  const PakEntry *PakFile = nullptr;
+};
+
+struct ResolvedPath {
+  StringId Name; // Normalized
+  PathEntry Entry;
+};
+
+static std::shared_mutex s_PathCacheMutex;
+static FlatHashMap<StringId, PathEntry> s_PathCache;
+static std::atomic<u64> s_PathCacheHits{0};
+static std::atomic<u64> s_PathCacheMisses{0};
+
+static ResolvedPath ResolvePath(const std::filesystem::path &path) {
+  ResolvedPath resolved;
+  resolved.Name = NormalizePath(path);
+  {
+    std::shared_lock lock(s_PathCacheMutex);
+    auto it = s_PathCache.find(resolved.Name);
+    if (it != s_PathCache.end()) {
+      s_PathCacheHits.fetch_add(1, std::memory_order_relaxed);
+      resolved.Entry = it->second;
+      return resolved;
+    }
+  }
+  s_PathCacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+  std::error_code error;
+  if (s_Initialized && PHYSFS_exists(resolved.Name.c_str())) {
+    resolved.Entry.Location = PathLocation::PhysFS;
+    if (const char *realDir = PHYSFS_getRealDir(resolved.Name.c_str())) {
+      resolved.Entry.RealDir = realDir;
+      resolved.Entry.InArchive = !std::filesystem::is_directory(realDir, error);
+    }
+  } else {
+    std::shared_lock lock(s_MountMutex);
+    const std::string_view name = resolved.Name.GetString();
+    for (const PakMount &mount : s_PakMounts) {
+      if (!name.starts_with(mount.MountPoint))
+        continue;
+      const PakEntry *entry =
+          mount.Reader->FindEntry(name.substr(mount.MountPoint.size()));
+      if (entry) {
+        resolved.Entry.Location = PathLocation::Pak;
+        resolved.Entry.Pak = mount.Reader.get();
+        resolved.Entry.PakFile = entry;
+        break;
+      }
+    }
+  }
+
+  if (resolved.Entry.Location == PathLocation::Missing) {
+    if (std::filesystem::exists(path, error)) {
+      resolved.Entry.Location = PathLocation::Native;
+    } else if (!IsBelowMountPoint(path, resolved.Name.GetString())) {
+      return resolved;
+    }
   }
+
+  std::unique_lock lock(s_PathCacheMutex);
+  s_PathCache.insert_or_assign(resolved.Name, resolved.Entry);
+  return resolved;
+}
+
+static void ForgetPath(const StringId &name) {
+  std::unique_lock lock(s_PathCacheMutex);
+  s_PathCache.erase(name);
+}
+
+std::shared_ptr<FileMapping>
+FileMapping::Open(const std::filesystem::path &path) {
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  auto mapping = std::make_shared<FileMapping>();
+  mapping->m_Size = static_cast<size_t>(size.QuadPart);
+  // Empty files cannot be mapped
+  if (mapping->m_Size > 0) {
+    // The view keeps the file and the section alive on its own
+    HANDLE section =
+        CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (section) {
+      mapping->m_View = static_cast<const u8 *>(
+          MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0));
+      CloseHandle(section);
+    }
+    if (!mapping->m_View) {
+      CloseHandle(file);
+      return nullptr;
+    }
+  }
+  CloseHandle(file);
+  return mapping;
+}
+
+FileMapping::~FileMapping() {
+  if (m_View)
+    UnmapViewOfFile(m_View);
+}
+
+// Archives PhysFS mounted (anything but a PAK), opened the first time one
+// of their stored entries is mapped
+static std::mutex s_ArchiveMutex;
+static std::unordered_map<std::string, std::unique_ptr<PakReader>> s_Archives;
+
+static const PakReader *GetPhysFSArchive(const std::string &path) {
+  std::lock_guard<std::mutex> lock(s_ArchiveMutex);
+  auto it = s_Archives.find(path);
+  if (it == s_Archives.end()) {
+    it = s_Archives.emplace(path, PakReader::Open(path)).first;
+  }
+  return it->second.get();
 }
 
 bool FileSystem::Initialize(const char *argv0) {
@@ -26,6 +218,7 @@ bool FileSystem::Initialize(const char *argv0) {
 
   HORSE_LOG_CORE_INFO("FileSystem Initialized.");
   s_Initialized = true;
+  InvalidatePathCache();
   return true;
 }
 
@@ -34,37 +227,104 @@ void FileSystem::Shutdown() {
     PHYSFS_deinit();
     s_Initialized = false;
   }
+  InvalidatePathCache();
+
+  // Views handed out keep their archive mapped on their own
+  {
+    std::unique_lock lock(s_MountMutex);
+    s_PakMounts.clear();
+    s_MountPoints.clear();
+  }
+  std::lock_guard<std::mutex> lock(s_ArchiveMutex);
+  s_Archives.clear();
 }
 
 bool FileSystem::Mount(const std::string &archive,
                        const std::string &mountPoint) {
+  // PAKs are read natively, directories and other archives through PhysFS
+  std::error_code error;
+  if (std::filesystem::path(archive).extension() == ".pak" &&
+      std::filesystem::is_regular_file(archive, error)) {
+    std::unique_ptr<PakReader> reader = PakReader::Open(archive);
+    if (!reader) {
+      HORSE_LOG_CORE_ERROR("Failed to mount {}", archive);
+      return false;
+    }
+    HORSE_LOG_CORE_INFO("Mounted: {} ({} entries)", archive,
+                        reader->GetEntries().size());
+
+    PakMount mount;
+    mount.MountPoint = NormalizeMountPoint(mountPoint);
+    mount.Reader = std::move(reader);
+    {
+      std::unique_lock lock(s_MountMutex);
+      s_MountPoints.push_back(mount.MountPoint);
+      s_PakMounts.push_back(std::move(mount));
+    }
+    InvalidatePathCache();
+    return true;
+  }
+
   if (PHYSFS_mount(archive.c_str(), mountPoint.c_str(), 1) == 0) {
     HORSE_LOG_CORE_ERROR("Failed to mount {}: {}", archive,
                          PHYSFS_getLastError());
     return false;
   }
   HORSE_LOG_CORE_INFO("Mounted: {}", archive);
+  {
+    std::unique_lock lock(s_MountMutex);
+    s_MountPoints.push_back(NormalizeMountPoint(mountPoint));
+  }
+  // The new mount may add or shadow files
+  InvalidatePathCache();
   return true;
 }
 
+void FileSystem::InvalidatePathCache() {
+  std::unique_lock lock(s_PathCacheMutex);
+  s_PathCache.clear();
+}
+
+void FileSystem::InvalidatePathCache(const std::filesystem::path &path) {
+  ForgetPath(NormalizePath(path));
+}
+
+PathCacheStats FileSystem::GetPathCacheStats() {
+  PathCacheStats stats;
+  stats.Hits = s_PathCacheHits.load(std::memory_order_relaxed);
+  stats.Misses = s_PathCacheMisses.load(std::memory_order_relaxed);
+  std::shared_lock lock(s_PathCacheMutex);
+  stats.Entries = s_PathCache.size();
+  return stats;
+}
+
 bool FileSystem::ReadBytes(const std::filesystem::path &path,
-                           std::vector<uint8_t> &outData) {
-  std::string pathStr = path.string();
-  CanonicalizePhysFSPath(pathStr);
+                           ByteBuffer &outData) {
+  const ResolvedPath resolved = ResolvePath(path);
+  if (resolved.Entry.Location == PathLocation::Missing)
+    return false;
+  if (resolved.Entry.Location == PathLocation::Pak)
+    return resolved.Entry.Pak->Read(*resolved.Entry.PakFile, outData);
 
-  if (s_Initialized) {
-    if (PHYSFS_exists(pathStr.c_str())) {
-      PHYSFS_File *file = PHYSFS_openRead(pathStr.c_str());
-      if (file) {
-        PHYSFS_sint64 len = PHYSFS_fileLength(file);
-        if (len >= 0) {
-          outData.resize(len);
-          PHYSFS_readBytes(file, outData.data(), len);
-          PHYSFS_close(file);
-          return true;
-        }
+  if (resolved.Entry.Location == PathLocation::PhysFS) {
+    PHYSFS_File *file = PHYSFS_openRead(resolved.Name.c_str());
+    if (file) {
+      PHYSFS_sint64 len = PHYSFS_fileLength(file);
+      if (len >= 0) {
+        outData.resize(len);
+        PHYSFS_sint64 read = PHYSFS_readBytes(file, outData.data(), len);
         PHYSFS_close(file);
+        if (read < 0) {
+          HORSE_LOG_CORE_ERROR("Failed to read {}: {}", resolved.Name.c_str(),
+                               PHYSFS_getLastError());
+          outData.clear();
+          return false;
+        }
+        // Never hand out the uninitialized tail of a short read
+        outData.resize(static_cast<size_t>(read));
+        return true;
       }
+      PHYSFS_close(file);
     }
   }
 
@@ -72,19 +332,22 @@ bool FileSystem::ReadBytes(const std::filesystem::path &path,
   // PhysFS) Note: PhysFS only sees mounted dirs. If Editor uses absolute paths,
   // we must fallback.
   std::ifstream stream(path, std::ios::binary | std::ios::ate);
-  if (!stream.is_open())
+  if (!stream.is_open()) {
+    ForgetPath(resolved.Name);
     return false;
+  }
 
   std::streamsize size = stream.tellg();
   stream.seekg(0, std::ios::beg);
   outData.resize(size);
   stream.read(reinterpret_cast<char *>(outData.data()), size);
+  outData.resize(static_cast<size_t>(stream.gcount()));
   return true;
 }
 
 bool FileSystem::ReadText(const std::filesystem::path &path,
                           std::string &outText) {
-  std::vector<uint8_t> data;
+  ByteBuffer data;
   if (ReadBytes(path, data)) {
     outText.assign(reinterpret_cast<const char *>(data.data()), data.size());
     return true;
@@ -92,21 +355,520 @@ bool FileSystem::ReadText(const std::filesystem::path &path,
   return false;
 }
 
-bool FileSystem::Exists(const std::filesystem::path &path) {
-  std::string pathStr = path.string();
-  CanonicalizePhysFSPath(pathStr);
+// Name of a PhysFS file below the directory or archive it was found in,
+// i.e. its path without the mount point
+static std::string_view GetNameInRealDir(const ResolvedPath &resolved) {
+  std::string_view name = resolved.Name.GetString();
+  const char *mountPoint =
+      PHYSFS_getMountPoint(resolved.Entry.RealDir.c_str());
+  std::string_view prefix = mountPoint ? mountPoint : "";
+  while (!prefix.empty() && prefix.front() == '/') {
+    prefix.remove_prefix(1);
+  }
+  if (name.starts_with(prefix)) {
+    name.remove_prefix(prefix.size());
+  }
+  return name;
+}
+
+MappedFile FileSystem::Map(const std::filesystem::path &path) {
+  const ResolvedPath resolved = ResolvePath(path);
+  MappedFile file;
+  if (resolved.Entry.Location == PathLocation::Missing)
+    return file;
+  if (resolved.Entry.Location == PathLocation::Pak)
+    return resolved.Entry.Pak->Map(*resolved.Entry.PakFile);
+
+  if (resolved.Entry.Location == PathLocation::PhysFS) {
+    if (!resolved.Entry.RealDir.IsEmpty()) {
+      const std::string &realDir = resolved.Entry.RealDir.GetString();
+      const std::string_view name = GetNameInRealDir(resolved);
+      if (resolved.Entry.InArchive) {
+        const PakReader *archive = GetPhysFSArchive(realDir);
+        const PakEntry *entry = archive ? archive->FindEntry(name) : nullptr;
+        if (entry && entry->IsStored()) {
+          file = archive->Map(*entry);
+          if (file)
+            return file;
+        }
+      } else if (std::shared_ptr<FileMapping> mapping = FileMapping::Open(
+                     std::filesystem::path(realDir) / name)) {
+        file.m_Data = mapping->GetData();
+        file.m_Size = mapping->GetSize();
+        file.m_Owner = std::move(mapping);
+        file.m_Mapped = true;
+        return file;
+      }
+    }
+
+    // Compressed entry: PhysFS inflates it into a buffer the view owns
+    auto buffer = std::make_shared<ByteBuffer>();
+    if (ReadBytes(path, *buffer)) {
+      file.m_Data = buffer->data();
+      file.m_Size = buffer->size();
+      file.m_Owner = std::move(buffer);
+    }
+    return file;
+  }
 
-  if (s_Initialized && PHYSFS_exists(pathStr.c_str())) {
+  // Same fallback as ReadBytes, for tools and absolute editor paths
+  if (std::shared_ptr<FileMapping> mapping = FileMapping::Open(path)) {
+    file.m_Data = mapping->GetData();
+    file.m_Size = mapping->GetSize();
+    file.m_Owner = std::move(mapping);
+    file.m_Mapped = true;
+  } else {
+    ForgetPath(resolved.Name);
+  }
+  return file;
+}
+
+bool FileSystem::CanMap(const std::filesystem::path &path) {
+  const ResolvedPath resolved = ResolvePath(path);
+  if (resolved.Entry.Location == PathLocation::Missing)
+    return false;
+  if (resolved.Entry.Location == PathLocation::Pak)
+    return resolved.Entry.PakFile->IsStored();
+  if (resolved.Entry.Location == PathLocation::Native)
     return true;
+
+  if (resolved.Entry.RealDir.IsEmpty())
+    return false;
+  if (!resolved.Entry.InArchive)
+    return true;
+  const PakReader *archive =
+      GetPhysFSArchive(resolved.Entry.RealDir.GetString());
+  const PakEntry *entry =
+      archive ? archive->FindEntry(GetNameInRealDir(resolved)) : nullptr;
+  return entry && entry->IsStored();
+}
+
+// Positional reads, so the stream needs no seek of its own
+class NativeStreamSource final : public FileStreamSource {
+public:
+  NativeStreamSource(HANDLE file, u64 size)
+      : FileStreamSource(size), m_File(file) {}
+  ~NativeStreamSource() override { CloseHandle(m_File); }
+
+  size_t Read(u64 offset, u8 *dest, size_t size) override {
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD read = 0;
+    if (!ReadFile(m_File, dest, static_cast<DWORD>(size), &read, &overlapped))
+      return 0;
+    return read;
   }
-  return std::filesystem::exists(path);
+
+private:
+  HANDLE m_File;
+};
+
+class PhysFSStreamSource final : public FileStreamSource {
+public:
+  PhysFSStreamSource(PHYSFS_File *file, u64 size)
+      : FileStreamSource(size), m_File(file) {}
+  ~PhysFSStreamSource() override { PHYSFS_close(m_File); }
+
+  size_t Read(u64 offset, u8 *dest, size_t size) override {
+    // Sequential reads never seek, which compressed entries would pay for
+    if (PHYSFS_tell(m_File) != static_cast<PHYSFS_sint64>(offset) &&
+        !PHYSFS_seek(m_File, offset))
+      return 0;
+    const PHYSFS_sint64 read = PHYSFS_readBytes(m_File, dest, size);
+    return read > 0 ? static_cast<size_t>(read) : 0;
+  }
+
+private:
+  PHYSFS_File *m_File;
+};
+
+FileStream::FileStream(std::unique_ptr<FileStreamSource> source,
+                       size_t chunkSize)
+    : m_Source(std::move(source)), m_ChunkSize(std::max<size_t>(chunkSize, 1)) {
+  m_Size = m_Source->GetSize();
+}
+
+// Claimed by either the job or the stream, whichever gets to it first. The
+// job holds its own reference, so a dropped job can still run after the
+// stream is gone.
+struct FileStream::ReadAheadJob {
+  enum : u8 { Queued, Running, Done, Dropped };
+  std::atomic<u8> State = Queued;
+};
+
+FileStream::~FileStream() { FinishReadAhead(); }
+
+bool FileStream::Fill() {
+  const u64 offset = Tell();
+  if (offset >= m_Size)
+    return false;
+
+  FinishReadAhead();
+  size_t size = 0;
+  if (m_AheadReady && offset >= m_AheadOffset &&
+      offset < m_AheadOffset + m_AheadSize) {
+    // The buffer two chunks back is free for the next read-ahead
+    std::swap(m_Previous, m_Chunk);
+    std::swap(m_Chunk, m_Ahead);
+    m_ChunkOffset = m_AheadOffset;
+    size = m_AheadSize;
+  } else {
+    std::swap(m_Previous, m_Chunk);
+    // Small files only get a buffer of their own size
+    m_Chunk.resize(static_cast<size_t>(std::min<u64>(m_ChunkSize, m_Size)));
+    m_ChunkOffset = offset;
+    size = m_Source->Read(offset, m_Chunk.data(),
+                          static_cast<size_t>(
+                              std::min<u64>(m_Chunk.size(), m_Size - offset)));
+  }
+  m_AheadReady = false;
+
+  m_Cursor = m_Chunk.data() + (offset - m_ChunkOffset);
+  m_End = m_Chunk.data() + size;
+  if (size == 0) {
+    HORSE_LOG_CORE_ERROR("FileStream: read failed at offset {}", offset);
+    return false;
+  }
+  StartReadAhead();
+  return true;
+}
+
+void FileStream::StartReadAhead() {
+  const u64 offset = m_ChunkOffset + (m_End - m_Chunk.data());
+  if (offset >= m_Size)
+    return;
+
+  // Without the JobSystem the job is dropped and Fill reads inline
+  m_AheadOffset = offset;
+  m_AheadJob = std::make_shared<ReadAheadJob>();
+  JobSystem::Execute(JobAffinity::IO, [this, job = m_AheadJob]() {
+    u8 state = ReadAheadJob::Queued;
+    if (!job->State.compare_exchange_strong(state, ReadAheadJob::Running))
+      return; // Dropped, the stream may already be destroyed
+    m_Ahead.resize(static_cast<size_t>(
+        std::min<u64>(m_ChunkSize, m_Size - m_AheadOffset)));
+    m_AheadSize = m_Source->Read(m_AheadOffset, m_Ahead.data(), m_Ahead.size());
+    m_AheadReady = true;
+    job->State.store(ReadAheadJob::Done);
+    job->State.notify_one();
+  });
+}
+
+void FileStream::FinishReadAhead() {
+  if (!m_AheadJob)
+    return;
+  // The IO thread runs jobs in order, so one still queued may sit behind
+  // unrelated reads; Fill then reads the chunk inline
+  u8 state = ReadAheadJob::Queued;
+  if (!m_AheadJob->State.compare_exchange_strong(state,
+                                                 ReadAheadJob::Dropped)) {
+    while (state == ReadAheadJob::Running) {
+      m_AheadJob->State.wait(state);
+      state = m_AheadJob->State.load();
+    }
+  }
+  m_AheadJob.reset();
+}
+
+size_t FileStream::Read(void *dest, size_t size) {
+  u8 *out = static_cast<u8 *>(dest);
+  size_t total = 0;
+  while (total < size && Peek()) {
+    const size_t count =
+        std::min(size - total, static_cast<size_t>(m_End - m_Cursor));
+    std::memcpy(out + total, m_Cursor, count);
+    m_Cursor += count;
+    total += count;
+  }
+  return total;
+}
+
+std::span<const u8> FileStream::ReadChunk() {
+  if (!Peek())
+    return {};
+  std::span<const u8> chunk(m_Cursor, m_End);
+  m_Cursor = m_End;
+  return chunk;
+}
+
+int FileStream::ReadCallback(void *user, char *data, int size) {
+  return static_cast<int>(
+      static_cast<FileStream *>(user)->Read(data, static_cast<size_t>(size)));
+}
+
+void FileStream::SkipCallback(void *user, int n) {
+  auto *stream = static_cast<FileStream *>(user);
+  const i64 target = static_cast<i64>(stream->Tell()) + n;
+  stream->Seek(std::min(static_cast<u64>(std::max<i64>(target, 0)),
+                        stream->GetSize()));
+}
+
+int FileStream::EofCallback(void *user) {
+  return static_cast<FileStream *>(user)->IsEOF() ? 1 : 0;
+}
+
+bool FileStream::Seek(u64 offset) {
+  if (offset > m_Size)
+    return false;
+
+  const u64 chunkEnd = m_ChunkOffset + (m_End - m_Chunk.data());
+  if (offset >= m_ChunkOffset && offset <= chunkEnd) {
+    m_Cursor = m_Chunk.data() + (offset - m_ChunkOffset);
+    return true;
+  }
+  // The next Fill reads at 'offset', from the read-ahead if it covers it
+  m_ChunkOffset = offset;
+  m_Cursor = m_End = m_Chunk.data();
+  return true;
+}
+
+std::unique_ptr<FileStream>
+FileSystem::OpenStream(const std::filesystem::path &path, size_t chunkSize) {
+  const ResolvedPath resolved = ResolvePath(path);
+  if (resolved.Entry.Location == PathLocation::Missing)
+    return nullptr;
+  if (resolved.Entry.Location == PathLocation::Pak)
+    return resolved.Entry.Pak->OpenStream(*resolved.Entry.PakFile, chunkSize);
+
+  if (resolved.Entry.Location == PathLocation::PhysFS) {
+    if (PHYSFS_File *file = PHYSFS_openRead(resolved.Name.c_str())) {
+      const PHYSFS_sint64 len = PHYSFS_fileLength(file);
+      if (len >= 0) {
+        return std::unique_ptr<FileStream>(new FileStream(
+            std::make_unique<PhysFSStreamSource>(file, len), chunkSize));
+      }
+      PHYSFS_close(file);
+    }
+  }
+
+  // Same fallback as ReadBytes, for tools and absolute editor paths
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    ForgetPath(resolved.Name);
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  return std::unique_ptr<FileStream>(new FileStream(
+      std::make_unique<NativeStreamSource>(file, size.QuadPart), chunkSize));
+}
+
+// ReadBytesAsync state. A request is shared by everyone asking for the same
+// file while it is queued or being read.
+enum class ReadState : u8 { Queued, Reading, Cancelled };
+
+struct ReadRequest {
+  std::filesystem::path Path;
+  std::string Key; // Canonical path
+  JobPriority Priority = JobPriority::Background;
+  ReadState State = ReadState::Queued;
+  std::vector<FileRequestID> Subscribers;
+};
+
+struct ReadSubscriber {
+  FileReadCallback Callback;
+  std::shared_ptr<ReadRequest> Request;
+};
+
+static constexpr size_t ReadPriorityCount =
+    static_cast<size_t>(JobPriority::Count);
+
+struct AsyncIOState {
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::vector<std::thread> Threads;
+  bool Running = false;
+  // A request moved to a higher priority stays in its old queue too; the
+  // stale entry is skipped once the request is no longer Queued
+  std::deque<std::shared_ptr<ReadRequest>> Queues[ReadPriorityCount];
+  std::unordered_map<std::string, std::shared_ptr<ReadRequest>> Pending;
+  std::unordered_map<FileRequestID, ReadSubscriber> Subscribers;
+  FileRequestID NextID = 1;
+};
+
+// Leaked on purpose: I/O threads must never be joined from a static
+// destructor, which runs under the loader lock when the engine is a DLL
+static AsyncIOState &GetAsyncIO() {
+  static AsyncIOState *s_AsyncIO = new AsyncIOState();
+  return *s_AsyncIO;
+}
+
+static std::shared_ptr<ReadRequest> PopReadRequest(AsyncIOState &io) {
+  for (auto &queue : io.Queues) {
+    while (!queue.empty()) {
+      std::shared_ptr<ReadRequest> request = std::move(queue.front());
+      queue.pop_front();
+      if (request->State == ReadState::Queued) {
+        return request;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Runs on the main thread. Callbacks cancelled in the meantime are gone
+// from the subscriber map and skipped.
+static void DeliverRead(const std::vector<FileRequestID> &subscribers,
+                        bool success, const ByteBuffer &data) {
+  AsyncIOState &io = GetAsyncIO();
+  for (FileRequestID id : subscribers) {
+    FileReadCallback callback;
+    {
+      std::lock_guard<std::mutex> lock(io.Mutex);
+      auto it = io.Subscribers.find(id);
+      if (it == io.Subscribers.end()) {
+        continue;
+      }
+      callback = std::move(it->second.Callback);
+      io.Subscribers.erase(it);
+    }
+    callback(success, data);
+  }
+}
+
+static void AsyncIOThread() {
+  AsyncIOState &io = GetAsyncIO();
+  for (;;) {
+    std::shared_ptr<ReadRequest> request;
+    {
+      std::unique_lock<std::mutex> lock(io.Mutex);
+      while (io.Running && !(request = PopReadRequest(io))) {
+        io.Condition.wait(lock);
+      }
+      if (!io.Running) {
+        return;
+      }
+      request->State = ReadState::Reading;
+    }
+
+    auto data = std::make_shared<ByteBuffer>();
+    const bool success = FileSystem::ReadBytes(request->Path, *data);
+    if (!success) {
+      HORSE_LOG_CORE_WARN("Async read failed: {}", request->Key);
+    }
+
+    std::vector<FileRequestID> subscribers;
+    {
+      std::lock_guard<std::mutex> lock(io.Mutex);
+      io.Pending.erase(request->Key);
+      subscribers = std::move(request->Subscribers);
+    }
+    if (!subscribers.empty()) {
+      JobSystem::Execute(JobAffinity::Main,
+                         [subscribers = std::move(subscribers),
+                          data = std::move(data), success]() {
+                           DeliverRead(subscribers, success, *data);
+                         });
+    }
+  }
+}
+
+void FileSystem::StartAsyncIO(u32 threadCount) {
+  AsyncIOState &io = GetAsyncIO();
+  std::lock_guard<std::mutex> lock(io.Mutex);
+  if (io.Running)
+    return;
+
+  io.Running = true;
+  threadCount = std::max(1u, threadCount);
+  for (u32 i = 0; i < threadCount; ++i) {
+    io.Threads.emplace_back(AsyncIOThread);
+  }
+  HORSE_LOG_CORE_INFO("Async I/O: {} threads", threadCount);
+}
+
+void FileSystem::StopAsyncIO() {
+  AsyncIOState &io = GetAsyncIO();
+  {
+    std::lock_guard<std::mutex> lock(io.Mutex);
+    if (!io.Running)
+      return;
+    io.Running = false;
+  }
+  io.Condition.notify_all();
+  for (std::thread &thread : io.Threads) {
+    thread.join();
+  }
+
+  // Deliveries still queued on the main thread find no subscribers
+  std::lock_guard<std::mutex> lock(io.Mutex);
+  io.Threads.clear();
+  for (auto &queue : io.Queues) {
+    queue.clear();
+  }
+  io.Pending.clear();
+  io.Subscribers.clear();
+}
+
+FileRequestID FileSystem::ReadBytesAsync(const std::filesystem::path &path,
+                                         JobPriority priority,
+                                         FileReadCallback callback) {
+  std::string key = NormalizePath(path);
+
+  AsyncIOState &io = GetAsyncIO();
+  std::unique_lock<std::mutex> lock(io.Mutex);
+  const FileRequestID id = io.NextID++;
+
+  if (!io.Running) {
+    lock.unlock();
+    ByteBuffer data;
+    const bool success = ReadBytes(path, data);
+    callback(success, data);
+    return id;
+  }
+
+  std::shared_ptr<ReadRequest> &request = io.Pending[key];
+  if (!request) {
+    request = std::make_shared<ReadRequest>();
+    request->Path = path;
+    request->Key = std::move(key);
+    request->Priority = priority;
+    io.Queues[static_cast<size_t>(priority)].push_back(request);
+    io.Condition.notify_one();
+  } else if (request->State == ReadState::Queued &&
+             priority < request->Priority) {
+    // Someone needs it sooner; the old queue entry is skipped later
+    request->Priority = priority;
+    io.Queues[static_cast<size_t>(priority)].push_back(request);
+    io.Condition.notify_one();
+  }
+  request->Subscribers.push_back(id);
+  io.Subscribers.emplace(id, ReadSubscriber{std::move(callback), request});
+  return id;
+}
+
+bool FileSystem::CancelRead(FileRequestID id) {
+  AsyncIOState &io = GetAsyncIO();
+  std::lock_guard<std::mutex> lock(io.Mutex);
+  auto it = io.Subscribers.find(id);
+  if (it == io.Subscribers.end()) {
+    return false;
+  }
+
+  std::shared_ptr<ReadRequest> request = std::move(it->second.Request);
+  io.Subscribers.erase(it);
+  std::erase(request->Subscribers, id);
+  if (request->State == ReadState::Queued && request->Subscribers.empty()) {
+    request->State = ReadState::Cancelled;
+    io.Pending.erase(request->Key);
+  }
+  return true;
+}
+
+bool FileSystem::Exists(const std::filesystem::path &path) {
+  return ResolvePath(path).Entry.Location != PathLocation::Missing;
 }
 
 std::vector<std::string>
 FileSystem::Enumerate(const std::filesystem::path &directory) {
   std::vector<std::string> results;
-  std::string pathStr = directory.string();
-  CanonicalizePhysFSPath(pathStr);
+  std::string pathStr = NormalizePath(directory);
 
   if (s_Initialized) {
     char **rc = PHYSFS_enumerateFiles(pathStr.c_str());
@@ -124,6 +886,32 @@ FileSystem::Enumerate(const std::filesystem::path &directory) {
       }
     }
   }
+
+  // Mounted PAKs only list files, so subdirectories come from entry paths
+  if (pathStr == ".") {
+    pathStr.clear();
+  }
+  if (!pathStr.empty() && pathStr.back() != '/') {
+    pathStr += '/';
+  }
+  std::shared_lock lock(s_MountMutex);
+  for (const PakMount &mount : s_PakMounts) {
+    if (!pathStr.starts_with(mount.MountPoint))
+      continue;
+    const std::string_view prefix =
+        std::string_view(pathStr).substr(mount.MountPoint.size());
+    for (const PakEntry &entry : mount.Reader->GetEntries()) {
+      std::string_view name = mount.Reader->GetName(entry);
+      if (!name.starts_with(prefix))
+        continue;
+      name.remove_prefix(prefix.size());
+      name = name.substr(0, name.find('/'));
+      if (!name.empty() &&
+          std::find(results.begin(), results.end(), name) == results.end()) {
+        results.emplace_back(name);
+      }
+    }
+  }
   return results;
 }
 
@@ -1,89 +1,713 @@
 #include "HorseEngine/Core/JobSystem.h"
-#include <thread>
-#include <queue>
-#include <mutex>
+#include "HorseEngine/Core/JobTask.h"
+#include "HorseEngine/Core/Time.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace Horse {
 
+// Shared pool of recycled jobs. Threads exchange whole batches with it, so
+// its mutex is taken once per JobPoolBatch allocations or frees. Jobs are
+// allocated in slabs and only returned to the heap at exit.
+static constexpr u32 JobPoolBatch = 128;
+
+class JobPool {
+public:
+    static JobPool& Get() {
+        static JobPool s_Pool;
+        return s_Pool;
+    }
+
+    Job* AcquireBatch(u32& count) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Batches.empty()) {
+            Batch batch = m_Batches.back();
+            m_Batches.pop_back();
+            count = batch.Count;
+            return batch.Head;
+        }
+
+        auto slab = std::make_unique<Job[]>(JobPoolBatch);
+        for (u32 i = 0; i + 1 < JobPoolBatch; ++i) {
+            slab[i].Next = &slab[i + 1];
+        }
+        Job* head = slab.get();
+        m_Slabs.push_back(std::move(slab));
+        count = JobPoolBatch;
+        return head;
+    }
+
+    void ReleaseBatch(Job* head, u32 count) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Batches.push_back({head, count});
+    }
+
+private:
+    struct Batch {
+        Job* Head;
+        u32 Count;
+    };
+
+    std::mutex m_Mutex;
+    std::vector<Batch> m_Batches;
+    std::vector<std::unique_ptr<Job[]>> m_Slabs;
+};
+
+// Per-thread free list. Jobs are usually allocated on one thread and freed
+// on another, so a cache that grows past two batches hands one back.
+class JobCache {
+public:
+    ~JobCache() {
+        if (m_Head) {
+            JobPool::Get().ReleaseBatch(m_Head, m_Count);
+        }
+    }
+
+    Job* Allocate() {
+        if (!m_Head) {
+            m_Head = JobPool::Get().AcquireBatch(m_Count);
+        }
+
+        Job* job = m_Head;
+        m_Head = job->Next;
+        --m_Count;
+
+        job->Next = nullptr;
+        job->Counter = nullptr;
+        job->QueuedAt = 0.0;
+        job->Affinity = JobAffinity::Any;
+        job->Priority = JobPriority::Normal;
+        return job;
+    }
+
+    void Free(Job* job) {
+        job->Next = m_Head;
+        m_Head = job;
+        if (++m_Count < JobPoolBatch * 2) {
+            return;
+        }
+
+        Job* tail = m_Head;
+        for (u32 i = 1; i < JobPoolBatch; ++i) {
+            tail = tail->Next;
+        }
+        Job* batch = m_Head;
+        m_Head = tail->Next;
+        tail->Next = nullptr;
+        m_Count -= JobPoolBatch;
+        JobPool::Get().ReleaseBatch(batch, JobPoolBatch);
+    }
+
+private:
+    Job* m_Head = nullptr;
+    u32 m_Count = 0;
+};
+
+static thread_local JobCache t_JobCache;
+
+// Chase-Lev work-stealing deque. The owning worker pushes and pops at the
+// bottom, every other thread steals from the top. Capacity is fixed; Push
+// returns false when full and the caller falls back to the global queue.
+class WorkStealingQueue {
+public:
+    static constexpr i64 Capacity = 4096;
+    static constexpr i64 Mask = Capacity - 1;
+
+    bool Push(Job* job) {
+        i64 bottom = m_Bottom.load(std::memory_order_relaxed);
+        i64 top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= Capacity) {
+            return false;
+        }
+
+        m_Buffer[bottom & Mask].store(job, std::memory_order_relaxed);
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* Pop() {
+        i64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // Empty
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[bottom & Mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last item, race against thieves for it
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* Steal() {
+        i64 top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 bottom = m_Bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[top & Mask].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return nullptr; // Lost the race to another thief or the owner
+        }
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<i64> m_Top{0};
+    alignas(64) std::atomic<i64> m_Bottom{0};
+    std::atomic<Job*> m_Buffer[Capacity] = {};
+};
+
+// Jobs bound to one thread. IO and Script own a thread each; the Main queue
+// is drained by PumpMainThread and by waits on the main thread.
+struct PinnedQueue {
+    std::deque<Job*> Jobs;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::atomic<u32> Size{0};
+    std::thread Thread;
+    bool Stop = false;
+};
+
+static constexpr u32 InvalidWorkerIndex = ~0u;
+static thread_local u32 t_WorkerIndex = InvalidWorkerIndex;
+static thread_local JobAffinity t_Affinity = JobAffinity::Any;
+static thread_local u32 t_RunDepth = 0; // Jobs running on this thread, nested by waits
+
+static constexpr size_t PriorityCount = static_cast<size_t>(JobPriority::Count);
+static constexpr size_t BackgroundPriority = static_cast<size_t>(JobPriority::Background);
+
+// Background jobs may start while the frame is younger than this, see
+// JobSystem::SetFrameBudget. Kept across Initialize/Shutdown.
+static std::atomic<f64> s_FrameBudget{1.0 / 60.0};
+
+// One deque per priority for every worker
+struct WorkerQueues {
+    WorkStealingQueue Queues[PriorityCount];
+};
+
 class JobSystemImpl {
 public:
     explicit JobSystemImpl(u32 numThreads) {
+        m_Queues.reserve(numThreads);
+        for (u32 i = 0; i < numThreads; ++i) {
+            m_Queues.emplace_back(std::make_unique<WorkerQueues>());
+        }
+
         m_Threads.reserve(numThreads);
         for (u32 i = 0; i < numThreads; ++i) {
-            m_Threads.emplace_back(&JobSystemImpl::WorkerThread, this);
+            m_Threads.emplace_back(&JobSystemImpl::WorkerThread, this, i);
+        }
+
+        t_Affinity = JobAffinity::Main;
+        for (JobAffinity affinity : {JobAffinity::IO, JobAffinity::Script}) {
+            GetPinnedQueue(affinity).Thread =
+                std::thread(&JobSystemImpl::PinnedThread, this, affinity);
         }
     }
-    
+
     ~JobSystemImpl() {
+        // Finish everything first; the main thread runs its own queue here.
+        // The frame budget no longer applies.
+        m_FrameStart.store(-1.0, std::memory_order_relaxed);
+        WakeWorkers();
+        WaitAll();
+
+        for (JobAffinity affinity : {JobAffinity::IO, JobAffinity::Script}) {
+            PinnedQueue& queue = GetPinnedQueue(affinity);
+            {
+                std::lock_guard<std::mutex> lock(queue.Mutex);
+                queue.Stop = true;
+            }
+            queue.Condition.notify_one();
+            queue.Thread.join();
+        }
+        t_Affinity = JobAffinity::Any;
+
         {
-            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
             m_Shutdown = true;
         }
-        m_Condition.notify_all();
-        
+        m_SleepCondition.notify_all();
+
         for (auto& thread : m_Threads) {
             if (thread.joinable()) {
                 thread.join();
             }
         }
     }
-    
-    void Execute(JobFunction&& job) {
-        {
-            std::unique_lock<std::mutex> lock(m_QueueMutex);
-            m_JobQueue.push(std::move(job));
-            m_ActiveJobs++;
+
+    void Execute(Job* job, JobCounter* counter,
+                 std::initializer_list<JobCounter*> dependencies) {
+        job->Counter = counter;
+        if (counter) {
+            counter->m_Value.fetch_add(1, std::memory_order_relaxed);
         }
-        m_Condition.notify_one();
+        m_ActiveJobs.fetch_add(1, std::memory_order_relaxed);
+
+        // One extra reference keeps the job from launching while it is
+        // still being registered with its prerequisites
+        job->PendingDependencies.store(static_cast<u32>(dependencies.size()) + 1,
+                                       std::memory_order_relaxed);
+        for (JobCounter* dependency : dependencies) {
+            AddDependent(dependency, job);
+        }
+        ReleaseDependency(job);
+    }
+
+    void Wait(JobCounter& counter) {
+        WaitUntil([&counter] { return counter.IsDone(); });
+
+        // The thread that zeroed the counter may still hold its mutex;
+        // wait for it so the caller can safely destroy the counter
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
     }
-    
+
     void WaitAll() {
-        std::unique_lock<std::mutex> lock(m_QueueMutex);
-        m_WaitCondition.wait(lock, [this] { return m_ActiveJobs == 0 && m_JobQueue.empty(); });
+        WaitUntil([this] { return m_ActiveJobs.load(std::memory_order_acquire) == 0; });
     }
-    
+
+    void PumpMainThread() {
+        if (t_Affinity != JobAffinity::Main) {
+            return;
+        }
+
+        PinnedQueue& queue = GetPinnedQueue(JobAffinity::Main);
+        const u32 count = queue.Size.load(std::memory_order_acquire);
+        for (u32 i = 0; i < count; ++i) {
+            Job* job = PopPinned(queue);
+            if (!job) {
+                break;
+            }
+            Run(job);
+        }
+    }
+
+    void BeginFrame() {
+        m_LastFrameStats.FrameCriticalJobs =
+            m_FrameCriticalJobs.exchange(0, std::memory_order_relaxed);
+        m_LastFrameStats.FrameCriticalWaitTotal =
+            m_FrameCriticalWaitNs.exchange(0, std::memory_order_relaxed) * 1e-9;
+        m_LastFrameStats.FrameCriticalWaitMax =
+            m_FrameCriticalWaitMaxNs.exchange(0, std::memory_order_relaxed) * 1e-9;
+
+        m_FrameStart.store(Time::GetTime(), std::memory_order_relaxed);
+
+        // Background jobs held back by the last frame may start again
+        if (m_QueuedJobs[BackgroundPriority].load(std::memory_order_seq_cst) > 0) {
+            WakeWorkers();
+        }
+    }
+
+    // Wakes every worker, e.g. after the budget changed
+    void WakeWorkers() {
+        { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+        m_SleepCondition.notify_all();
+        NotifyWaiters();
+    }
+
+    bool IsOverFrameBudget() const {
+        const f64 frameStart = m_FrameStart.load(std::memory_order_relaxed);
+        const f64 budget = s_FrameBudget.load(std::memory_order_relaxed);
+        return frameStart >= 0.0 && budget > 0.0 && Time::GetTime() - frameStart >= budget;
+    }
+
+    const JobFrameStats& GetFrameStats() const { return m_LastFrameStats; }
+
     u32 GetThreadCount() const { return static_cast<u32>(m_Threads.size()); }
-    
+
 private:
-    void WorkerThread() {
+    void AddDependent(JobCounter* dependency, Job* job) {
+        if (dependency) {
+            std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+            if (!dependency->IsDone()) {
+                dependency->m_Dependents.push_back(job);
+                return;
+            }
+        }
+        ReleaseDependency(job);
+    }
+
+    void ReleaseDependency(Job* job) {
+        if (job->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Submit(job);
+        }
+    }
+
+    void SignalCounter(JobCounter* counter) {
+        u32 value = counter->m_Value.load(std::memory_order_relaxed);
         while (true) {
-            JobFunction job;
-            
-            {
-                std::unique_lock<std::mutex> lock(m_QueueMutex);
-                m_Condition.wait(lock, [this] { return m_Shutdown || !m_JobQueue.empty(); });
-                
-                if (m_Shutdown && m_JobQueue.empty()) {
+            if (value != 1) {
+                if (counter->m_Value.compare_exchange_weak(value, value - 1,
+                                                           std::memory_order_acq_rel)) {
                     return;
                 }
-                
-                if (!m_JobQueue.empty()) {
-                    job = std::move(m_JobQueue.front());
-                    m_JobQueue.pop();
+                continue;
+            }
+
+            // Last job of the group: zero the counter under its mutex so
+            // dependents registered concurrently are never missed
+            std::vector<Job*> ready;
+            {
+                std::lock_guard<std::mutex> lock(counter->m_Mutex);
+                if (!counter->m_Value.compare_exchange_strong(value, 0,
+                                                              std::memory_order_seq_cst)) {
+                    continue;
                 }
+                ready.swap(counter->m_Dependents);
+            }
+
+            for (Job* job : ready) {
+                ReleaseDependency(job);
+            }
+            NotifyWaiters();
+            return;
+        }
+    }
+
+    void Submit(Job* job) {
+        if (job->Affinity != JobAffinity::Any) {
+            PinnedQueue& queue = GetPinnedQueue(job->Affinity);
+            {
+                std::lock_guard<std::mutex> lock(queue.Mutex);
+                queue.Jobs.push_back(job);
+                queue.Size.fetch_add(1, std::memory_order_seq_cst);
+            }
+            queue.Condition.notify_one();
+            NotifyWaiters();
+            return;
+        }
+
+        const size_t priority = static_cast<size_t>(job->Priority);
+        if (job->Priority == JobPriority::FrameCritical) {
+            job->QueuedAt = Time::GetTime();
+        }
+        m_QueuedJobs[priority].fetch_add(1, std::memory_order_seq_cst);
+
+        // Workers feed their own deque; everyone else goes through the
+        // shared injection queue
+        if (t_WorkerIndex >= m_Queues.size() ||
+            !m_Queues[t_WorkerIndex]->Queues[priority].Push(job)) {
+            std::lock_guard<std::mutex> lock(m_GlobalMutex);
+            m_GlobalQueues[priority].push_back(job);
+            m_GlobalQueueSizes[priority].fetch_add(1, std::memory_order_release);
+        }
+
+        Wake();
+    }
+
+    void Wake() {
+        if (m_SleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+            { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+            m_SleepCondition.notify_one();
+        }
+        NotifyWaiters();
+    }
+
+    void NotifyWaiters() {
+        if (m_WaitingThreads.load(std::memory_order_seq_cst) > 0) {
+            { std::lock_guard<std::mutex> lock(m_WaitMutex); }
+            m_WaitCondition.notify_all();
+        }
+    }
+
+    bool HasUrgentJobs() const {
+        for (size_t priority = 0; priority < BackgroundPriority; ++priority) {
+            if (m_QueuedJobs[priority].load(std::memory_order_seq_cst) > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Someone waits, nothing urgent is queued and every running job is
+    // itself stuck in a wait: only held-back background work can make
+    // progress now
+    bool IsStalled() const {
+        const u32 waitingInJobs = m_WaitingInJobs.load(std::memory_order_seq_cst);
+        return m_Waiters.load(std::memory_order_seq_cst) > 0 && !HasUrgentJobs() &&
+               m_RunningJobs.load(std::memory_order_seq_cst) <= waitingInJobs;
+    }
+
+    // Background jobs start while the frame is within budget, or when
+    // holding them back any longer would deadlock a wait
+    bool BackgroundAllowed() const { return !IsOverFrameBudget() || IsStalled(); }
+
+    bool HasRunnableJobs() const {
+        return HasUrgentJobs() ||
+               (m_QueuedJobs[BackgroundPriority].load(std::memory_order_seq_cst) > 0 &&
+                BackgroundAllowed());
+    }
+
+    void WakeForBackground() {
+        if (m_QueuedJobs[BackgroundPriority].load(std::memory_order_seq_cst) > 0 &&
+            m_Waiters.load(std::memory_order_seq_cst) > 0) {
+            WakeWorkers();
+        }
+    }
+
+    PinnedQueue& GetPinnedQueue(JobAffinity affinity) {
+        return m_Pinned[static_cast<size_t>(affinity)];
+    }
+
+    static Job* PopPinned(PinnedQueue& queue) {
+        if (queue.Size.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        if (queue.Jobs.empty()) {
+            return nullptr;
+        }
+        Job* job = queue.Jobs.front();
+        queue.Jobs.pop_front();
+        queue.Size.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    Job* FindJob(u32 workerIndex) {
+        for (size_t priority = 0; priority < PriorityCount; ++priority) {
+            if (m_QueuedJobs[priority].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            if (priority == BackgroundPriority && !BackgroundAllowed()) {
+                break;
+            }
+            if (Job* job = FindJob(workerIndex, priority)) {
+                m_QueuedJobs[priority].fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    Job* FindJob(u32 workerIndex, size_t priority) {
+        Job* job = nullptr;
+
+        if (workerIndex < m_Queues.size()) {
+            job = m_Queues[workerIndex]->Queues[priority].Pop();
+        }
+
+        if (!job && m_GlobalQueueSizes[priority].load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(m_GlobalMutex);
+            std::deque<Job*>& queue = m_GlobalQueues[priority];
+            if (!queue.empty()) {
+                job = queue.front();
+                queue.pop_front();
+                m_GlobalQueueSizes[priority].fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!job) {
+            const u32 count = static_cast<u32>(m_Queues.size());
+            const u32 start = NextVictim(count);
+            for (u32 i = 0; i < count && !job; ++i) {
+                u32 victim = (start + i) % count;
+                if (victim != workerIndex) {
+                    job = m_Queues[victim]->Queues[priority].Steal();
+                }
+            }
+        }
+
+        return job;
+    }
+
+    static u32 NextVictim(u32 count) {
+        // xorshift, per thread, so thieves spread across victims
+        static thread_local u32 s_State =
+            static_cast<u32>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+        s_State ^= s_State << 13;
+        s_State ^= s_State >> 17;
+        s_State ^= s_State << 5;
+        return count > 0 ? s_State % count : 0;
+    }
+
+    void RecordQueueWait(f64 seconds) {
+        const u64 waitNs = static_cast<u64>(std::max(seconds, 0.0) * 1e9);
+        m_FrameCriticalJobs.fetch_add(1, std::memory_order_relaxed);
+        m_FrameCriticalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+
+        u64 maxNs = m_FrameCriticalWaitMaxNs.load(std::memory_order_relaxed);
+        while (waitNs > maxNs &&
+               !m_FrameCriticalWaitMaxNs.compare_exchange_weak(maxNs, waitNs,
+                                                               std::memory_order_relaxed)) {
+        }
+    }
+
+    void Run(Job* job) {
+        if (job->Priority == JobPriority::FrameCritical && job->Affinity == JobAffinity::Any) {
+            RecordQueueWait(Time::GetTime() - job->QueuedAt);
+        }
+
+        m_RunningJobs.fetch_add(1, std::memory_order_seq_cst);
+        ++t_RunDepth;
+        job->Invoke(job);
+        job->Destroy(job);
+        --t_RunDepth;
+
+        // Captures are gone before the counter releases any waiter
+        JobCounter* counter = job->Counter;
+        t_JobCache.Free(job);
+        if (counter) {
+            SignalCounter(counter);
+        }
+
+        m_RunningJobs.fetch_sub(1, std::memory_order_seq_cst);
+        if (m_ActiveJobs.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            NotifyWaiters();
+        }
+        WakeForBackground();
+    }
+
+    // Workers run queued jobs while they wait, so waiting from inside a job
+    // never starves the pool. Pinned threads only run jobs bound to them, so
+    // they must not pick up an unrelated long job and stall the frame, but
+    // can still wait on work that needs their own thread. Other threads
+    // just block.
+    template <typename Predicate>
+    void WaitUntil(Predicate&& done) {
+        if (done()) {
+            return;
+        }
+
+        const bool isWorker = t_WorkerIndex < m_Queues.size();
+        PinnedQueue* pinned =
+            t_Affinity != JobAffinity::Any ? &GetPinnedQueue(t_Affinity) : nullptr;
+
+        // Waiters are tracked to detect stalls, see IsStalled
+        const bool inJob = t_RunDepth > 0;
+        if (inJob) {
+            m_WaitingInJobs.fetch_add(1, std::memory_order_seq_cst);
+        }
+        m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+        WakeForBackground();
+
+        while (!done()) {
+            Job* job = nullptr;
+            if (isWorker) {
+                job = FindJob(t_WorkerIndex);
+            } else if (pinned) {
+                job = PopPinned(*pinned);
             }
-            
             if (job) {
-                job();
-                
-                {
-                    std::unique_lock<std::mutex> lock(m_QueueMutex);
-                    m_ActiveJobs--;
-                    if (m_ActiveJobs == 0 && m_JobQueue.empty()) {
-                        m_WaitCondition.notify_all();
-                    }
+                Run(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_WaitMutex);
+            m_WaitingThreads.fetch_add(1, std::memory_order_seq_cst);
+            m_WaitCondition.wait(lock, [&] {
+                return done() || (isWorker && HasRunnableJobs()) ||
+                       (pinned && pinned->Size.load(std::memory_order_seq_cst) > 0);
+            });
+            m_WaitingThreads.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+        if (inJob) {
+            m_WaitingInJobs.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void WorkerThread(u32 index) {
+        t_WorkerIndex = index;
+
+        while (true) {
+            Job* job = FindJob(index);
+
+            // Spin briefly before parking; jobs usually arrive in bursts
+            for (u32 spin = 0; !job && spin < 64; ++spin) {
+                std::this_thread::yield();
+                job = FindJob(index);
+            }
+
+            if (job) {
+                Run(job);
+                continue;
+            }
+
+            // Queues are drained before a worker honours shutdown
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            if (m_Shutdown) {
+                return;
+            }
+
+            m_SleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            m_SleepCondition.wait(lock, [this] { return m_Shutdown || HasRunnableJobs(); });
+            m_SleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void PinnedThread(JobAffinity affinity) {
+        t_Affinity = affinity;
+        PinnedQueue& queue = GetPinnedQueue(affinity);
+
+        while (true) {
+            Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(queue.Mutex);
+                queue.Condition.wait(lock, [&queue] { return queue.Stop || !queue.Jobs.empty(); });
+                if (queue.Jobs.empty()) {
+                    return;
                 }
+                job = queue.Jobs.front();
+                queue.Jobs.pop_front();
+                queue.Size.fetch_sub(1, std::memory_order_relaxed);
             }
+            Run(job);
         }
     }
-    
+
     std::vector<std::thread> m_Threads;
-    std::queue<JobFunction> m_JobQueue;
-    std::mutex m_QueueMutex;
-    std::condition_variable m_Condition;
+    std::vector<std::unique_ptr<WorkerQueues>> m_Queues;
+
+    std::deque<Job*> m_GlobalQueues[PriorityCount];
+    std::mutex m_GlobalMutex;
+    std::atomic<u32> m_GlobalQueueSizes[PriorityCount] = {};
+
+    std::mutex m_SleepMutex;
+    std::condition_variable m_SleepCondition;
+    std::atomic<u32> m_SleepingWorkers{0};
+
+    std::mutex m_WaitMutex;
     std::condition_variable m_WaitCondition;
+    std::atomic<u32> m_WaitingThreads{0};
+    std::atomic<u32> m_Waiters{0};       // Threads inside WaitUntil
+    std::atomic<u32> m_WaitingInJobs{0}; // ... that are inside a running job
+    std::atomic<u32> m_RunningJobs{0};
+
+    PinnedQueue m_Pinned[static_cast<size_t>(JobAffinity::Count)]; // Any unused
+
+    std::atomic<f64> m_FrameStart{-1.0}; // < 0 until the first BeginFrame
+
+    std::atomic<u32> m_FrameCriticalJobs{0};
+    std::atomic<u64> m_FrameCriticalWaitNs{0};
+    std::atomic<u64> m_FrameCriticalWaitMaxNs{0};
+    JobFrameStats m_LastFrameStats;
+
+    std::atomic<u32> m_QueuedJobs[PriorityCount] = {};
     std::atomic<u32> m_ActiveJobs{0};
     bool m_Shutdown = false;
 };
@@ -102,9 +726,81 @@ void JobSystem::Shutdown() {
     s_Impl = nullptr;
 }
 
-void JobSystem::Execute(JobFunction&& job) {
+Job* JobSystem::AllocateJob() {
+    return t_JobCache.Allocate();
+}
+
+void JobSystem::Schedule(Job* job, JobCounter* counter,
+                         std::initializer_list<JobCounter*> dependencies) {
+    if (s_Impl) {
+        s_Impl->Execute(job, counter, dependencies);
+        return;
+    }
+
+    // Not running: the job is dropped
+    job->Destroy(job);
+    t_JobCache.Free(job);
+}
+
+void JobSystem::Execute(JobTask&& task, JobCounter* counter,
+                        std::initializer_list<JobCounter*> dependencies) {
+    Execute(JobPriority::Normal, std::move(task), counter, dependencies);
+}
+
+void JobSystem::Execute(JobPriority priority, JobTask&& task, JobCounter* counter,
+                        std::initializer_list<JobCounter*> dependencies) {
+    JobTask::Handle coroutine = task.Release();
+    coroutine.promise().Counter = counter;
+    coroutine.promise().Priority = priority;
+    Execute(priority, JobTask::Resumer(coroutine), counter, dependencies);
+}
+
+void JobSystem::Execute(JobAffinity affinity, JobTask&& task, JobCounter* counter,
+                        std::initializer_list<JobCounter*> dependencies) {
+    JobTask::Handle coroutine = task.Release();
+    coroutine.promise().Counter = counter;
+    coroutine.promise().Affinity = affinity;
+    Execute(affinity, JobTask::Resumer(coroutine), counter, dependencies);
+}
+
+void JobSystem::BeginFrame() {
+    if (s_Impl) {
+        s_Impl->BeginFrame();
+    }
+}
+
+void JobSystem::SetFrameBudget(f64 seconds) {
+    s_FrameBudget.store(seconds, std::memory_order_relaxed);
+    if (s_Impl) {
+        s_Impl->WakeWorkers();
+    }
+}
+
+f64 JobSystem::GetFrameBudget() {
+    return s_FrameBudget.load(std::memory_order_relaxed);
+}
+
+bool JobSystem::IsOverFrameBudget() {
+    return s_Impl && s_Impl->IsOverFrameBudget();
+}
+
+JobFrameStats JobSystem::GetFrameStats() {
+    return s_Impl ? s_Impl->GetFrameStats() : JobFrameStats{};
+}
+
+void JobSystem::PumpMainThread() {
+    if (s_Impl) {
+        s_Impl->PumpMainThread();
+    }
+}
+
+bool JobSystem::IsMainThread() {
+    return t_Affinity == JobAffinity::Main;
+}
+
+void JobSystem::Wait(JobCounter& counter) {
     if (s_Impl) {
-        s_Impl->Execute(std::move(job));
+        s_Impl->Wait(counter);
     }
 }
 
@@ -114,6 +810,90 @@ void JobSystem::WaitAll() {
     }
 }
 
+// ParallelFor chunk sizing. A chunk should run long enough to hide the cost
+// of scheduling it, and there should be a few chunks per thread so uneven
+// items still balance out.
+static constexpr f64 ParallelForProbeSeconds = 5e-6;
+static constexpr f64 ParallelForChunkSeconds = 50e-6;
+static constexpr u32 ParallelForChunksPerThread = 4;
+
+void JobSystem::ParallelForRange(u32 begin, u32 end, u32 grain,
+                                 const JobRangeFunction& fn) {
+    if (begin >= end) {
+        return;
+    }
+
+    const u32 threads = GetThreadCount();
+    if (threads == 0) {
+        fn(begin, end);
+        return;
+    }
+
+    if (grain == 0) {
+        // Run a doubling batch of items inline until the elapsed time is
+        // measurable. Small loops finish entirely inside the probe.
+        const u32 probeLimit = std::max(1u, (end - begin) / (threads + 1));
+        const auto start = std::chrono::steady_clock::now();
+        u32 probed = 0;
+        f64 elapsed = 0.0;
+        for (u32 batch = 1; begin < end; batch *= 2) {
+            u32 last = begin + std::min(batch, end - begin);
+            fn(begin, last);
+            probed += last - begin;
+            begin = last;
+
+            elapsed = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= ParallelForProbeSeconds || probed >= probeLimit) {
+                break;
+            }
+        }
+
+        if (begin >= end) {
+            return;
+        }
+
+        const u32 remaining = end - begin;
+        const f64 perItem = std::max(elapsed / probed, 1e-9);
+        const f64 minChunk = std::ceil(ParallelForChunkSeconds / perItem);
+        const u32 balancedChunk =
+            (remaining + (threads + 1) * ParallelForChunksPerThread - 1) /
+            ((threads + 1) * ParallelForChunksPerThread);
+        grain = minChunk >= remaining ? remaining
+                                      : std::max(static_cast<u32>(minChunk), balancedChunk);
+    }
+
+    const u32 remaining = end - begin;
+    if (grain >= remaining) {
+        fn(begin, end);
+        return;
+    }
+
+    // Helpers and the caller pull chunks from a shared cursor, so a slow
+    // chunk never holds up the rest of the range
+    std::atomic<u64> next{begin};
+    auto runChunks = [&next, end, grain, &fn]() {
+        while (true) {
+            u64 first = next.fetch_add(grain, std::memory_order_relaxed);
+            if (first >= end) {
+                return;
+            }
+            u32 last = static_cast<u32>(std::min<u64>(first + grain, end));
+            fn(static_cast<u32>(first), last);
+        }
+    };
+
+    const u32 chunks = (remaining + grain - 1) / grain;
+    const u32 helpers = std::min(threads, chunks - 1);
+
+    // The caller is blocked on these, so they go ahead of everything else
+    JobCounter counter;
+    for (u32 i = 0; i < helpers; ++i) {
+        Execute(JobPriority::FrameCritical, runChunks, &counter);
+    }
+    runChunks();
+    Wait(counter);
+}
+
 u32 JobSystem::GetThreadCount() {
     return s_Impl ? s_Impl->GetThreadCount() : 0;
 }
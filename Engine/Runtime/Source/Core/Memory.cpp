@@ -1,18 +1,85 @@
 #include "HorseEngine/Core/Memory.h"
+#include "HorseEngine/Core/ByteBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <new>
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#ifdef HORSE_USE_MIMALLOC
+#include <mimalloc.h>
+#endif
 
 namespace Horse {
 
-LinearAllocator::LinearAllocator(size_t capacity)
-    : m_Capacity(capacity) {
+#ifdef HORSE_USE_MIMALLOC
+// Referencing mimalloc keeps its override DLL in the import table, so it is
+// loaded, and redirects the CRT heap, before the engine allocates anything
+static const int s_MimallocVersion = mi_version();
+#endif
+
+const char* GetHeapName() {
+#ifdef HORSE_USE_MIMALLOC
+    return "mimalloc";
+#else
+    return "CRT";
+#endif
+}
+
+// Virtual memory is committed and decommitted in steps of this size
+static constexpr size_t CommitGranularity = 64 * 1024;
+
+// An arena whose peak usage stayed under half of its committed memory for
+// this many resets (about two seconds of frames) gives the rest back
+static constexpr u32 TrimAfterResets = 120;
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static u8* ReserveMemory(size_t size) {
+    return static_cast<u8*>(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+}
+
+static bool CommitMemory(u8* address, size_t size) {
+    return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+static void DecommitMemory(u8* address, size_t size) {
+    VirtualFree(address, size, MEM_DECOMMIT);
+}
+
+static void ReleaseMemory(u8* address) {
+    VirtualFree(address, 0, MEM_RELEASE);
+}
+
+LinearAllocator::LinearAllocator(size_t capacity, MemoryBacking backing)
+    : m_Capacity(capacity), m_Backing(backing) {
+    if (m_Backing == MemoryBacking::Virtual) {
+        m_Capacity = AlignUp(capacity, CommitGranularity);
+        m_Buffer = ReserveMemory(m_Capacity);
+        if (!m_Buffer) {
+            m_Capacity = 0;
+        }
+        return;
+    }
+
     m_Buffer = static_cast<u8*>(std::malloc(capacity));
     std::memset(m_Buffer, 0, capacity);
 }
 
 LinearAllocator::~LinearAllocator() {
     if (m_Buffer) {
-        std::free(m_Buffer);
+        if (m_Backing == MemoryBacking::Virtual) {
+            ReleaseMemory(m_Buffer);
+        } else {
+            std::free(m_Buffer);
+        }
         m_Buffer = nullptr;
     }
 }
@@ -28,6 +95,15 @@ void* LinearAllocator::Allocate(size_t size, size_t alignment) {
     if (m_Offset + padding + size > m_Capacity) {
         return nullptr; // Out of memory
     }
+
+    const size_t end = m_Offset + padding + size;
+    if (m_Backing == MemoryBacking::Virtual && end > m_Committed) {
+        const size_t target = std::min(AlignUp(end, CommitGranularity), m_Capacity);
+        if (!CommitMemory(m_Buffer + m_Committed, target - m_Committed)) {
+            return nullptr;
+        }
+        m_Committed = target;
+    }
     
     m_Offset += padding;
     void* ptr = m_Buffer + m_Offset;
@@ -37,14 +113,265 @@ void* LinearAllocator::Allocate(size_t size, size_t alignment) {
 }
 
 void LinearAllocator::Reset() {
+    if (m_Backing == MemoryBacking::Virtual) {
+        m_TrimPeak = std::max(m_TrimPeak, m_Offset);
+        if (++m_ResetsSinceTrim >= TrimAfterResets) {
+            const size_t keep = AlignUp(std::max<size_t>(m_TrimPeak, 1), CommitGranularity);
+            if (keep * 2 <= m_Committed) {
+                DecommitMemory(m_Buffer + keep, m_Committed - keep);
+                m_Committed = keep;
+            }
+            m_TrimPeak = 0;
+            m_ResetsSinceTrim = 0;
+        }
+    }
+
     m_Offset = 0;
 }
 
+// StackAllocator
+
+StackAllocator::StackAllocator(size_t capacity, MemoryBacking backing)
+    : m_Memory(capacity, backing) {}
+
+void* StackAllocator::Allocate(size_t size, size_t alignment) {
+    return m_Memory.Allocate(size, alignment);
+}
+
+StackAllocator::Marker StackAllocator::GetMarker() {
+    return {m_Memory.m_Offset, ++m_Depth};
+}
+
+void StackAllocator::FreeToMarker(const Marker& marker) {
+    // Freeing an outer marker first would pull memory from under the
+    // inner scope that is still using it
+    assert(marker.Depth == m_Depth && "StackAllocator markers freed out of order");
+    assert(marker.Offset <= m_Memory.m_Offset && "StackAllocator marker is stale");
+    m_Memory.m_Offset = marker.Offset;
+    --m_Depth;
+}
+
+// ConcurrentLinearAllocator
+
+struct ConcurrentLinearAllocator::Page {
+    Page* Next;
+    size_t Capacity;
+    std::atomic<size_t> Offset;
+    std::atomic<size_t> Committed; // From the start of the page, header included
+
+    u8* Data() { return reinterpret_cast<u8*>(this + 1); }
+};
+
+// Generations are unique across all allocators, so a thread's cached chunk
+// can only match the allocator and Reset it was taken from
+static std::atomic<u64> s_NextGeneration{1};
+
+// Small per-thread cache of chunks, one per allocator in use
+struct ThreadChunk {
+    u64 Generation = 0;
+    u8* Cursor = nullptr;
+    u8* End = nullptr;
+};
+
+static constexpr u32 ThreadChunkCount = 4;
+static thread_local ThreadChunk t_Chunks[ThreadChunkCount];
+static thread_local u32 t_NextChunk = 0;
+
+static u8* AlignPointer(u8* ptr, size_t alignment) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    return ptr + (((address + alignment - 1) & ~(uintptr_t)(alignment - 1)) - address);
+}
+
+ConcurrentLinearAllocator::ConcurrentLinearAllocator(size_t pageSize, size_t chunkSize)
+    : m_PageSize(pageSize), m_ChunkSize(chunkSize) {
+    m_First = CreatePage(pageSize);
+    m_Current.store(m_First, std::memory_order_relaxed);
+    if (m_First) {
+        m_Capacity.store(m_First->Capacity, std::memory_order_relaxed);
+        m_Committed.store(m_First->Committed, std::memory_order_relaxed);
+    }
+    m_Generation.store(s_NextGeneration.fetch_add(1), std::memory_order_relaxed);
+}
+
+ConcurrentLinearAllocator::~ConcurrentLinearAllocator() {
+    Page* page = m_First;
+    while (page) {
+        Page* next = page->Next;
+        DestroyPage(page);
+        page = next;
+    }
+}
+
+// Reserves the page and commits only the part holding its header
+ConcurrentLinearAllocator::Page* ConcurrentLinearAllocator::CreatePage(size_t capacity) {
+    const size_t size = AlignUp(sizeof(Page) + capacity, CommitGranularity);
+    u8* memory = ReserveMemory(size);
+    if (!memory) {
+        return nullptr;
+    }
+    if (!CommitMemory(memory, CommitGranularity)) {
+        ReleaseMemory(memory);
+        return nullptr;
+    }
+    return new (memory) Page{nullptr, size - sizeof(Page), {0}, {CommitGranularity}};
+}
+
+void ConcurrentLinearAllocator::DestroyPage(Page* page) {
+    page->~Page();
+    ReleaseMemory(reinterpret_cast<u8*>(page));
+}
+
+void* ConcurrentLinearAllocator::Allocate(size_t size, size_t alignment) {
+    if (alignment == 0) {
+        alignment = 1;
+    }
+    if (size > m_ChunkSize / 4) {
+        return AllocateShared(size, alignment);
+    }
+
+    const u64 generation = m_Generation.load(std::memory_order_relaxed);
+    ThreadChunk* chunk = nullptr;
+    for (ThreadChunk& cached : t_Chunks) {
+        if (cached.Generation == generation) {
+            chunk = &cached;
+            break;
+        }
+    }
+    if (!chunk) {
+        chunk = &t_Chunks[t_NextChunk++ % ThreadChunkCount];
+        *chunk = {generation, nullptr, nullptr};
+    }
+
+    u8* ptr = chunk->Cursor ? AlignPointer(chunk->Cursor, alignment) : nullptr;
+    if (!ptr || ptr + size > chunk->End) {
+        u8* memory = static_cast<u8*>(AllocateShared(m_ChunkSize, 16));
+        if (!memory) {
+            return nullptr;
+        }
+        chunk->End = memory + m_ChunkSize;
+        ptr = AlignPointer(memory, alignment);
+    }
+    chunk->Cursor = ptr + size;
+    return ptr;
+}
+
+void* ConcurrentLinearAllocator::AllocateShared(size_t size, size_t alignment) {
+    // Reserve room to align anywhere in the page, so a single fetch_add does
+    const size_t reserve = size + alignment - 1;
+    while (true) {
+        Page* page = m_Current.load(std::memory_order_acquire);
+        if (!page) {
+            return nullptr;
+        }
+        const size_t offset = page->Offset.fetch_add(reserve, std::memory_order_relaxed);
+        if (offset + reserve <= page->Capacity) {
+            if (!Commit(page, offset + reserve)) {
+                return nullptr;
+            }
+            m_Used.fetch_add(reserve, std::memory_order_relaxed);
+            return AlignPointer(page->Data() + offset, alignment);
+        }
+        Grow(page, reserve);
+    }
+}
+
+// Makes sure the page is backed up to 'end' bytes of data
+bool ConcurrentLinearAllocator::Commit(Page* page, size_t end) {
+    end += sizeof(Page);
+    if (page->Committed.load(std::memory_order_acquire) >= end) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_GrowMutex);
+    const size_t committed = page->Committed.load(std::memory_order_relaxed);
+    if (committed >= end) {
+        return true;
+    }
+    const size_t target = std::min(AlignUp(end, CommitGranularity), sizeof(Page) + page->Capacity);
+    if (!CommitMemory(reinterpret_cast<u8*>(page) + committed, target - committed)) {
+        return false;
+    }
+    m_Committed.fetch_add(target - committed, std::memory_order_relaxed);
+    page->Committed.store(target, std::memory_order_release);
+    return true;
+}
+
+// Moves past a full page to the next kept page that fits, or chains a new
+// one after it
+void ConcurrentLinearAllocator::Grow(Page* full, size_t size) {
+    std::lock_guard<std::mutex> lock(m_GrowMutex);
+    if (m_Current.load(std::memory_order_relaxed) != full) {
+        return; // Another thread already moved on
+    }
+
+    Page* next = full->Next;
+    if (next && next->Capacity >= size) {
+        next->Offset.store(0, std::memory_order_relaxed);
+    } else {
+        Page* page = CreatePage(std::max(m_PageSize, size));
+        if (!page) {
+            m_Current.store(nullptr, std::memory_order_release);
+            return;
+        }
+        page->Next = next;
+        full->Next = page;
+        next = page;
+        m_Capacity.fetch_add(page->Capacity, std::memory_order_relaxed);
+        m_Committed.fetch_add(page->Committed, std::memory_order_relaxed);
+    }
+    m_Current.store(next, std::memory_order_release);
+}
+
+void ConcurrentLinearAllocator::Reset() {
+    const size_t used = m_Used.exchange(0, std::memory_order_relaxed);
+    m_LastUsed = used;
+    m_PeakUsed = std::max(m_PeakUsed, used);
+
+    m_TrimPeak = std::max(m_TrimPeak, used);
+    if (++m_ResetsSinceTrim >= TrimAfterResets) {
+        Trim(m_TrimPeak);
+        m_TrimPeak = 0;
+        m_ResetsSinceTrim = 0;
+    }
+
+    if (m_First) {
+        m_First->Offset.store(0, std::memory_order_relaxed);
+    }
+    m_Current.store(m_First, std::memory_order_release);
+    m_Generation.store(s_NextGeneration.fetch_add(1), std::memory_order_relaxed);
+}
+
+// Gives back overflow pages and committed memory that 'peak' usage didn't
+// need. Only called from Reset.
+void ConcurrentLinearAllocator::Trim(size_t peak) {
+    if (!m_First || peak > m_First->Capacity) {
+        return; // Still needs the overflow pages
+    }
+
+    Page* page = m_First->Next;
+    m_First->Next = nullptr;
+    while (page) {
+        Page* next = page->Next;
+        m_Capacity.fetch_sub(page->Capacity, std::memory_order_relaxed);
+        m_Committed.fetch_sub(page->Committed, std::memory_order_relaxed);
+        DestroyPage(page);
+        page = next;
+    }
+
+    const size_t keep = AlignUp(sizeof(Page) + peak, CommitGranularity);
+    const size_t committed = m_First->Committed.load(std::memory_order_relaxed);
+    if (keep * 2 <= committed) {
+        DecommitMemory(reinterpret_cast<u8*>(m_First) + keep, committed - keep);
+        m_First->Committed.store(keep, std::memory_order_relaxed);
+        m_Committed.fetch_sub(committed - keep, std::memory_order_relaxed);
+    }
+}
+
 // FrameAllocator static members
-std::unique_ptr<LinearAllocator> FrameAllocator::s_Allocator;
+std::unique_ptr<ConcurrentLinearAllocator> FrameAllocator::s_Allocator;
 
 void FrameAllocator::Initialize(size_t capacity) {
-    s_Allocator = std::make_unique<LinearAllocator>(capacity);
+    s_Allocator = std::make_unique<ConcurrentLinearAllocator>(capacity);
 }
 
 void FrameAllocator::Shutdown() {
@@ -61,4 +388,275 @@ void* FrameAllocator::Allocate(size_t size, size_t alignment) {
     return s_Allocator ? s_Allocator->Allocate(size, alignment) : nullptr;
 }
 
+FrameAllocatorStats FrameAllocator::GetStats() {
+    if (!s_Allocator) {
+        return {};
+    }
+    return {s_Allocator->GetUsed(), s_Allocator->GetLastUsed(),
+            s_Allocator->GetPeakUsed(), s_Allocator->GetCapacity(),
+            s_Allocator->GetCommitted()};
+}
+
+// BufferedFrameAllocator static members
+std::vector<std::unique_ptr<ConcurrentLinearAllocator>> BufferedFrameAllocator::s_Buffers;
+u32 BufferedFrameAllocator::s_Current = 0;
+
+void BufferedFrameAllocator::Initialize(size_t capacity, u32 frameCount) {
+    s_Buffers.clear();
+    for (u32 i = 0; i < std::max(frameCount, 1u); ++i) {
+        s_Buffers.push_back(std::make_unique<ConcurrentLinearAllocator>(capacity));
+    }
+    s_Current = 0;
+}
+
+void BufferedFrameAllocator::Shutdown() {
+    s_Buffers.clear();
+}
+
+void BufferedFrameAllocator::NextFrame() {
+    if (s_Buffers.empty()) {
+        return;
+    }
+    // The buffer coming up was last filled frameCount frames ago
+    s_Current = (s_Current + 1) % static_cast<u32>(s_Buffers.size());
+    s_Buffers[s_Current]->Reset();
+}
+
+void* BufferedFrameAllocator::Allocate(size_t size, size_t alignment) {
+    return s_Buffers.empty() ? nullptr : s_Buffers[s_Current]->Allocate(size, alignment);
+}
+
+FrameAllocatorStats BufferedFrameAllocator::GetStats() {
+    if (s_Buffers.empty()) {
+        return {};
+    }
+    const ConcurrentLinearAllocator& buffer = *s_Buffers[s_Current];
+    return {buffer.GetUsed(), buffer.GetLastUsed(), buffer.GetPeakUsed(),
+            buffer.GetCapacity(), buffer.GetCommitted()};
+}
+
+// ScratchArena
+
+struct ScratchArena::Block {
+    Block* Next;
+    size_t Capacity;
+    size_t Offset;
+
+    u8* Data() { return reinterpret_cast<u8*>(this + 1); }
+};
+
+static constexpr size_t ScratchBlockSize = 64 * 1024;
+
+// Bumped by NewFrame; each arena compares it with the frame it last saw
+static std::atomic<u64> s_ScratchFrame{0};
+
+ScratchArena& ScratchArena::Get() {
+    thread_local ScratchArena t_Arena;
+    return t_Arena;
+}
+
+void ScratchArena::NewFrame() {
+    s_ScratchFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+ScratchArena::~ScratchArena() {
+    Block* block = m_First;
+    while (block) {
+        Block* next = block->Next;
+        std::free(block);
+        block = next;
+    }
+}
+
+void ScratchArena::SyncFrame() {
+    const u64 frame = s_ScratchFrame.load(std::memory_order_relaxed);
+    if (frame != m_Frame) {
+        m_Frame = frame;
+        m_Current = m_First;
+        if (m_Current) {
+            m_Current->Offset = 0;
+        }
+    }
+}
+
+static size_t AlignedOffset(ScratchArena::Block* block, size_t alignment) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block->Data()) + block->Offset;
+    const uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return block->Offset + (aligned - address);
+}
+
+void* ScratchArena::Allocate(size_t size, size_t alignment) {
+    SyncFrame();
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    if (m_Current) {
+        const size_t offset = AlignedOffset(m_Current, alignment);
+        if (offset + size <= m_Current->Capacity) {
+            m_Current->Offset = offset + size;
+            return m_Current->Data() + offset;
+        }
+    }
+
+    Block* block = NextBlock(size, alignment);
+    if (!block) {
+        return nullptr;
+    }
+    const size_t offset = AlignedOffset(block, alignment);
+    block->Offset = offset + size;
+    return block->Data() + offset;
+}
+
+// Moves to the next kept block that fits, or chains a new one after the
+// current block
+ScratchArena::Block* ScratchArena::NextBlock(size_t size, size_t alignment) {
+    const size_t needed = size + alignment;
+    Block* next = m_Current ? m_Current->Next : m_First;
+    if (next && next->Capacity >= needed) {
+        next->Offset = 0;
+        m_Current = next;
+        return next;
+    }
+
+    const size_t capacity = std::max(ScratchBlockSize, needed);
+    Block* block = static_cast<Block*>(std::malloc(sizeof(Block) + capacity));
+    if (!block) {
+        return nullptr;
+    }
+    block->Next = next;
+    block->Capacity = capacity;
+    block->Offset = 0;
+    if (m_Current) {
+        m_Current->Next = block;
+    } else {
+        m_First = block;
+    }
+    m_Current = block;
+    return block;
+}
+
+ScratchArena::Marker ScratchArena::GetMarker() {
+    SyncFrame();
+    return {m_Current, m_Current ? m_Current->Offset : 0, m_Frame};
+}
+
+void ScratchArena::FreeToMarker(const Marker& marker) {
+    // A frame boundary in between already freed everything
+    if (marker.Frame != m_Frame) {
+        return;
+    }
+    m_Current = marker.Position;
+    if (m_Current) {
+        m_Current->Offset = marker.Offset;
+    } else if (m_First) {
+        m_Current = m_First;
+        m_Current->Offset = 0;
+    }
+}
+
+size_t ScratchArena::GetUsed() const {
+    size_t used = 0;
+    for (Block* block = m_First; block; block = block->Next) {
+        used += block->Offset;
+        if (block == m_Current) {
+            break;
+        }
+    }
+    return used;
+}
+
+size_t ScratchArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (Block* block = m_First; block; block = block->Next) {
+        capacity += block->Capacity;
+    }
+    return capacity;
+}
+
+// ByteBuffer
+
+// Large page size once the privilege was acquired, 0 while disabled
+static std::atomic<size_t> s_LargePageSize{0};
+
+bool ByteBuffer::EnableLargePages() {
+    if (s_LargePageSize.load() != 0) {
+        return true;
+    }
+
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        return false;
+    }
+    TOKEN_PRIVILEGES privileges = {};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    // AdjustTokenPrivileges succeeds even if the account lacks the right;
+    // only the last error tells
+    const bool enabled =
+        LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+        AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+        GetLastError() == ERROR_SUCCESS;
+    CloseHandle(token);
+
+    const size_t pageSize = enabled ? GetLargePageMinimum() : 0;
+    s_LargePageSize.store(pageSize);
+    return pageSize != 0;
+}
+
+bool ByteBuffer::IsLargePagesEnabled() {
+    return s_LargePageSize.load() != 0;
+}
+
+void ByteBuffer::resize(size_t size) {
+    if (size > m_Capacity) {
+        reserve(std::max(size, m_Capacity + m_Capacity / 2));
+    }
+    m_Size = size;
+}
+
+void ByteBuffer::reserve(size_t capacity) {
+    if (capacity <= m_Capacity) {
+        return;
+    }
+
+    u8* data = nullptr;
+    bool largePages = false;
+    const size_t largePageSize = s_LargePageSize.load();
+    if (largePageSize != 0 && capacity >= LargePageThreshold) {
+        // Needs physically contiguous memory, which a fragmented system may
+        // not have; the heap is the fallback
+        capacity = AlignUp(capacity, largePageSize);
+        data = static_cast<u8*>(VirtualAlloc(nullptr, capacity,
+                                             MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                             PAGE_READWRITE));
+        largePages = data != nullptr;
+    }
+    if (!data) {
+        data = static_cast<u8*>(std::malloc(capacity));
+        if (!data) {
+            throw std::bad_alloc();
+        }
+    }
+
+    if (m_Size > 0) {
+        std::memcpy(data, m_Data, m_Size);
+    }
+    Release();
+    m_Data = data;
+    m_Capacity = capacity;
+    m_LargePages = largePages;
+}
+
+void ByteBuffer::Release() {
+    if (m_LargePages) {
+        ReleaseMemory(m_Data);
+    } else {
+        std::free(m_Data);
+    }
+    m_Data = nullptr;
+    m_Capacity = 0;
+    m_LargePages = false;
+}
+
 } // namespace Horse
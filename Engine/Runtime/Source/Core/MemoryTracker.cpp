@@ -0,0 +1,177 @@
+#include "HorseEngine/Core/MemoryTracker.h"
+#include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Time.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace Horse {
+
+// Sits right before every block handed out
+struct AllocationHeader {
+  size_t Size;
+  u32 Offset; // From the start of the malloc'ed block
+  MemoryTag Tag;
+};
+
+static constexpr size_t HeaderSize = 16;
+static_assert(sizeof(AllocationHeader) <= HeaderSize);
+
+struct TagCounters {
+  std::atomic<size_t> LiveBytes{0};
+  std::atomic<size_t> PeakBytes{0};
+  std::atomic<u64> LiveAllocations{0};
+  std::atomic<u64> TotalAllocations{0};
+};
+
+static TagCounters s_Counters[static_cast<size_t>(MemoryTag::Count)];
+
+static f64 s_ReportInterval = 0.0;
+static f64 s_LastReport = 0.0;
+
+static AllocationHeader *GetHeader(void *ptr) {
+  return reinterpret_cast<AllocationHeader *>(static_cast<u8 *>(ptr) -
+                                              HeaderSize);
+}
+
+static void RecordAllocation(MemoryTag tag, size_t size) {
+  TagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+  const size_t live =
+      counters.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+  while (live > peak && !counters.PeakBytes.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {
+  }
+  counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+  counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void RecordFree(MemoryTag tag, size_t size) {
+  TagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+  counters.LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+  counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void *MemoryTracker::Allocate(size_t size, MemoryTag tag, size_t alignment) {
+  alignment = std::max(alignment, HeaderSize);
+  // malloc is 16-byte aligned, so only over-aligned blocks need slack
+  const size_t slack = alignment - HeaderSize;
+  u8 *block = static_cast<u8 *>(std::malloc(HeaderSize + slack + size));
+  if (!block) {
+    return nullptr;
+  }
+
+  const uintptr_t address = reinterpret_cast<uintptr_t>(block) + HeaderSize;
+  u8 *ptr = block + HeaderSize +
+            (((address + alignment - 1) & ~(uintptr_t)(alignment - 1)) -
+             address);
+
+  AllocationHeader *header = GetHeader(ptr);
+  header->Size = size;
+  header->Offset = static_cast<u32>(ptr - block);
+  header->Tag = tag;
+  RecordAllocation(tag, size);
+  return ptr;
+}
+
+void *MemoryTracker::Reallocate(void *ptr, size_t size, MemoryTag tag,
+                                size_t alignment) {
+  if (!ptr) {
+    return Allocate(size, tag, alignment);
+  }
+
+  AllocationHeader *header = GetHeader(ptr);
+  const size_t oldSize = header->Size;
+  const MemoryTag oldTag = header->Tag;
+
+  if (header->Offset != HeaderSize) {
+    // Over-aligned: realloc wouldn't keep the alignment
+    void *moved = Allocate(size, tag, alignment);
+    if (moved) {
+      std::memcpy(moved, ptr, std::min(oldSize, size));
+      Free(ptr);
+    }
+    return moved;
+  }
+
+  u8 *block = static_cast<u8 *>(
+      std::realloc(static_cast<u8 *>(ptr) - HeaderSize, HeaderSize + size));
+  if (!block) {
+    return nullptr;
+  }
+  RecordFree(oldTag, oldSize);
+  RecordAllocation(tag, size);
+
+  header = reinterpret_cast<AllocationHeader *>(block);
+  header->Size = size;
+  header->Tag = tag;
+  return block + HeaderSize;
+}
+
+void MemoryTracker::Free(void *ptr) {
+  if (!ptr) {
+    return;
+  }
+  AllocationHeader *header = GetHeader(ptr);
+  RecordFree(header->Tag, header->Size);
+  std::free(static_cast<u8 *>(ptr) - header->Offset);
+}
+
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag) {
+  const TagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+  return {counters.LiveBytes.load(std::memory_order_relaxed),
+          counters.PeakBytes.load(std::memory_order_relaxed),
+          counters.LiveAllocations.load(std::memory_order_relaxed),
+          counters.TotalAllocations.load(std::memory_order_relaxed)};
+}
+
+const char *MemoryTracker::GetTagName(MemoryTag tag) {
+  switch (tag) {
+  case MemoryTag::Core:
+    return "Core";
+  case MemoryTag::Scene:
+    return "Scene";
+  case MemoryTag::Physics:
+    return "Physics";
+  case MemoryTag::Script:
+    return "Script";
+  case MemoryTag::Asset:
+    return "Asset";
+  case MemoryTag::Render:
+    return "Render";
+  default:
+    return "Unknown";
+  }
+}
+
+void MemoryTracker::LogReport() {
+  constexpr f64 MB = 1024.0 * 1024.0;
+  for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+    const MemoryTag tag = static_cast<MemoryTag>(i);
+    const MemoryTagStats stats = GetStats(tag);
+    HORSE_LOG_CORE_INFO("Memory [{}]: {:.2f} MB live in {} allocations, "
+                        "{:.2f} MB peak, {} allocations total",
+                        GetTagName(tag), stats.LiveBytes / MB,
+                        stats.LiveAllocations, stats.PeakBytes / MB,
+                        stats.TotalAllocations);
+  }
+}
+
+void MemoryTracker::SetReportInterval(f64 seconds) {
+  s_ReportInterval = seconds;
+  s_LastReport = Time::GetTime();
+}
+
+void MemoryTracker::Update() {
+  if (s_ReportInterval <= 0.0) {
+    return;
+  }
+  const f64 now = Time::GetTime();
+  if (now - s_LastReport >= s_ReportInterval) {
+    s_LastReport = now;
+    LogReport();
+  }
+}
+
+} // namespace Horse
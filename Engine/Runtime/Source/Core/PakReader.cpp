@@ -0,0 +1,331 @@
+#include "HorseEngine/Core/PakReader.h"
+#include "FileMapping.h"
+#include "FileStreamSource.h"
+#include "HorseEngine/Core/JobSystem.h"
+#include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/StringId.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <zlib.h>
+
+namespace Horse {
+
+static constexpr u32 EndRecordSignature = 0x06054b50;
+static constexpr u32 DirectoryHeaderSignature = 0x02014b50;
+static constexpr u32 LocalHeaderSignature = 0x04034b50;
+static constexpr size_t EndRecordSize = 22;
+static constexpr size_t DirectoryHeaderSize = 46;
+static constexpr size_t LocalHeaderSize = 30;
+
+template <typename T> static T ReadLE(const u8 *bytes) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+// Raw deflate, as stored in ZIP archives
+static bool Inflate(std::span<const u8> source, u8 *dest, size_t destSize) {
+  if (destSize == 0)
+    return true;
+
+  z_stream stream = {};
+  if (inflateInit2(&stream, -15) != Z_OK)
+    return false;
+  stream.next_in = const_cast<Bytef *>(source.data());
+  stream.avail_in = static_cast<uInt>(source.size());
+  stream.next_out = dest;
+  stream.avail_out = static_cast<uInt>(destSize);
+  const int result = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+  return result == Z_STREAM_END && stream.total_out == destSize;
+}
+
+std::unique_ptr<PakReader> PakReader::Open(const std::filesystem::path &path) {
+  std::shared_ptr<FileMapping> mapping = FileMapping::Open(path);
+  if (!mapping || mapping->GetSize() < EndRecordSize)
+    return nullptr;
+
+  const u8 *data = mapping->GetData();
+  const size_t size = mapping->GetSize();
+
+  // The end record is last unless the archive carries a comment
+  size_t end = size - EndRecordSize;
+  const size_t searchLimit = end > 0xFFFF ? end - 0xFFFF : 0;
+  while (ReadLE<u32>(data + end) != EndRecordSignature) {
+    if (end == searchLimit) {
+      HORSE_LOG_CORE_ERROR("Not a PAK archive: {}", path.string());
+      return nullptr;
+    }
+    --end;
+  }
+
+  const u16 count = ReadLE<u16>(data + end + 10);
+  const u32 directorySize = ReadLE<u32>(data + end + 12);
+  const u32 directoryOffset = ReadLE<u32>(data + end + 16);
+  if (static_cast<u64>(directoryOffset) + directorySize > end) {
+    HORSE_LOG_CORE_ERROR("Corrupt PAK directory: {}", path.string());
+    return nullptr;
+  }
+
+  std::unique_ptr<PakReader> reader(new PakReader());
+  reader->m_Path = path;
+  reader->m_Entries.reserve(count);
+  reader->m_Names.reserve(directorySize);
+
+  const u8 *record = data + directoryOffset;
+  const u8 *directoryEnd = record + directorySize;
+  for (u16 i = 0; i < count; ++i) {
+    if (record + DirectoryHeaderSize > directoryEnd ||
+        ReadLE<u32>(record) != DirectoryHeaderSignature) {
+      HORSE_LOG_CORE_ERROR("Corrupt PAK directory: {}", path.string());
+      return nullptr;
+    }
+
+    const u16 nameLength = ReadLE<u16>(record + 28);
+    const u16 extraLength = ReadLE<u16>(record + 30);
+    const u16 commentLength = ReadLE<u16>(record + 32);
+    const char *name = reinterpret_cast<const char *>(record) +
+                       DirectoryHeaderSize;
+    if (record + DirectoryHeaderSize + nameLength > directoryEnd) {
+      HORSE_LOG_CORE_ERROR("Corrupt PAK directory: {}", path.string());
+      return nullptr;
+    }
+
+    PakEntry entry;
+    entry.NameHash = HashString({name, nameLength});
+    entry.HeaderOffset = ReadLE<u32>(record + 42);
+    entry.CompressedSize = ReadLE<u32>(record + 20);
+    entry.UncompressedSize = ReadLE<u32>(record + 24);
+    entry.NameOffset = static_cast<u32>(reader->m_Names.size());
+    entry.NameLength = nameLength;
+    entry.Method = ReadLE<u16>(record + 10);
+    reader->m_Names.append(name, nameLength);
+
+    // Directories have no data
+    if (nameLength == 0 || name[nameLength - 1] != '/') {
+      reader->m_Entries.push_back(entry);
+    }
+    record += DirectoryHeaderSize + nameLength + extraLength + commentLength;
+  }
+
+  std::sort(reader->m_Entries.begin(), reader->m_Entries.end(),
+            [](const PakEntry &a, const PakEntry &b) {
+              return a.NameHash < b.NameHash;
+            });
+  reader->m_Index.reserve(reader->m_Entries.size());
+  for (u32 i = 0; i < reader->m_Entries.size(); ++i) {
+    const PakEntry &entry = reader->m_Entries[i];
+    if (!reader->m_Index.try_emplace(entry.NameHash, i).second) {
+      HORSE_LOG_CORE_ERROR("PAK {}: duplicate or colliding entry {}",
+                           path.string(), reader->GetName(entry));
+    }
+  }
+
+  reader->m_Mapping = std::move(mapping);
+  return reader;
+}
+
+PakReader::~PakReader() = default;
+
+const PakEntry *PakReader::FindEntry(std::string_view name) const {
+  auto it = m_Index.find(HashString(name));
+  if (it == m_Index.end())
+    return nullptr;
+  const PakEntry &entry = m_Entries[it->second];
+  return GetName(entry) == name ? &entry : nullptr;
+}
+
+std::span<const u8> PakReader::GetRawBytes(const PakEntry &entry) const {
+  // The local header repeats the name and may carry its own extra field
+  const u8 *data = m_Mapping->GetData();
+  const size_t size = m_Mapping->GetSize();
+  if (entry.HeaderOffset + LocalHeaderSize > size)
+    return {};
+  const u8 *header = data + entry.HeaderOffset;
+  if (ReadLE<u32>(header) != LocalHeaderSignature)
+    return {};
+
+  const u64 offset = entry.HeaderOffset + LocalHeaderSize +
+                     ReadLE<u16>(header + 26) + ReadLE<u16>(header + 28);
+  if (offset + entry.CompressedSize > size)
+    return {};
+  return {data + offset, entry.CompressedSize};
+}
+
+bool PakReader::Read(const PakEntry &entry, ByteBuffer &outData) const {
+  const std::span<const u8> raw = GetRawBytes(entry);
+  if (raw.size() != entry.CompressedSize)
+    return false;
+
+  outData.resize(entry.UncompressedSize);
+  if (entry.IsStored()) {
+    if (entry.CompressedSize != entry.UncompressedSize)
+      return false;
+    std::memcpy(outData.data(), raw.data(), raw.size());
+    return true;
+  }
+  if (entry.Method == Z_DEFLATED &&
+      Inflate(raw, outData.data(), outData.size()))
+    return true;
+
+  HORSE_LOG_CORE_ERROR("PAK {}: cannot read {}", m_Path.string(),
+                       GetName(entry));
+  outData.clear();
+  return false;
+}
+
+MappedFile PakReader::Map(const PakEntry &entry) const {
+  MappedFile file;
+  if (entry.IsStored()) {
+    const std::span<const u8> raw = GetRawBytes(entry);
+    if (raw.size() == entry.CompressedSize &&
+        entry.CompressedSize == entry.UncompressedSize) {
+      file.m_Owner = m_Mapping;
+      file.m_Data = raw.data();
+      file.m_Size = raw.size();
+      file.m_Mapped = true;
+    }
+    return file;
+  }
+
+  auto buffer = std::make_shared<ByteBuffer>();
+  if (Read(entry, *buffer)) {
+    file.m_Data = buffer->data();
+    file.m_Size = buffer->size();
+    file.m_Owner = std::move(buffer);
+  }
+  return file;
+}
+
+// Stored entries are copied out of the mapping as the stream asks
+class StoredStreamSource final : public FileStreamSource {
+public:
+  StoredStreamSource(std::shared_ptr<FileMapping> mapping,
+                     std::span<const u8> data)
+      : FileStreamSource(data.size()), m_Mapping(std::move(mapping)),
+        m_Data(data) {}
+
+  size_t Read(u64 offset, u8 *dest, size_t size) override {
+    if (offset >= m_Data.size())
+      return 0;
+    const size_t count =
+        std::min(size, m_Data.size() - static_cast<size_t>(offset));
+    std::memcpy(dest, m_Data.data() + offset, count);
+    return count;
+  }
+
+private:
+  std::shared_ptr<FileMapping> m_Mapping;
+  std::span<const u8> m_Data;
+};
+
+// Deflated entries are inflated chunk by chunk. Seeking forward inflates
+// and drops the bytes in between, seeking backwards starts over.
+class InflateStreamSource final : public FileStreamSource {
+public:
+  InflateStreamSource(std::shared_ptr<FileMapping> mapping,
+                      std::span<const u8> source, u64 size)
+      : FileStreamSource(size), m_Mapping(std::move(mapping)),
+        m_Source(source) {}
+  ~InflateStreamSource() override {
+    if (m_Initialized)
+      inflateEnd(&m_Stream);
+  }
+
+  bool Initialize() {
+    m_Initialized = inflateInit2(&m_Stream, -15) == Z_OK;
+    Restart();
+    return m_Initialized;
+  }
+
+  size_t Read(u64 offset, u8 *dest, size_t size) override {
+    if (offset < m_Position) {
+      if (inflateReset(&m_Stream) != Z_OK)
+        return 0;
+      Restart();
+    }
+    while (m_Position < offset) {
+      const size_t skip =
+          static_cast<size_t>(std::min<u64>(size, offset - m_Position));
+      if (Inflate(dest, skip) != skip)
+        return 0;
+    }
+    return Inflate(dest, size);
+  }
+
+private:
+  void Restart() {
+    m_Stream.next_in = const_cast<Bytef *>(m_Source.data());
+    m_Stream.avail_in = static_cast<uInt>(m_Source.size());
+    m_Position = 0;
+    m_Finished = false;
+  }
+
+  size_t Inflate(u8 *dest, size_t size) {
+    m_Stream.next_out = dest;
+    m_Stream.avail_out = static_cast<uInt>(size);
+    // The whole input is mapped, so this only stops when 'dest' is full,
+    // at the end of the entry or on corrupt data
+    while (m_Stream.avail_out > 0 && !m_Finished) {
+      const int result = inflate(&m_Stream, Z_NO_FLUSH);
+      if (result == Z_STREAM_END) {
+        m_Finished = true;
+      } else if (result != Z_OK) {
+        break;
+      }
+    }
+    const size_t produced = size - m_Stream.avail_out;
+    m_Position += produced;
+    return produced;
+  }
+
+  std::shared_ptr<FileMapping> m_Mapping;
+  std::span<const u8> m_Source;
+  z_stream m_Stream = {};
+  u64 m_Position = 0; // Uncompressed bytes produced so far
+  bool m_Initialized = false;
+  bool m_Finished = false;
+};
+
+std::unique_ptr<FileStream> PakReader::OpenStream(const PakEntry &entry,
+                                                  size_t chunkSize) const {
+  const std::span<const u8> raw = GetRawBytes(entry);
+  if (raw.size() != entry.CompressedSize)
+    return nullptr;
+
+  std::unique_ptr<FileStreamSource> source;
+  if (entry.IsStored() && entry.CompressedSize == entry.UncompressedSize) {
+    source = std::make_unique<StoredStreamSource>(m_Mapping, raw);
+  } else if (entry.Method == Z_DEFLATED) {
+    auto inflater = std::make_unique<InflateStreamSource>(
+        m_Mapping, raw, entry.UncompressedSize);
+    if (inflater->Initialize()) {
+      source = std::move(inflater);
+    }
+  }
+  if (!source) {
+    HORSE_LOG_CORE_ERROR("PAK {}: cannot read {}", m_Path.string(),
+                         GetName(entry));
+    return nullptr;
+  }
+  return std::unique_ptr<FileStream>(
+      new FileStream(std::move(source), chunkSize));
+}
+
+bool PakReader::ReadBatch(std::span<const PakEntry *const> entries,
+                          std::span<ByteBuffer> outData) const {
+  assert(entries.size() == outData.size());
+  std::atomic<bool> success = true;
+  // Grain 0: lets the job system size chunks, tiny entries stay inline
+  JobSystem::ParallelFor(0, static_cast<u32>(entries.size()), 0,
+                         [&](u32 i) {
+                           if (!Read(*entries[i], outData[i])) {
+                             success.store(false, std::memory_order_relaxed);
+                           }
+                         });
+  return success.load();
+}
+
+} // namespace Horse
@@ -0,0 +1,56 @@
+#include "HorseEngine/Core/StringId.h"
+#include <cassert>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Horse {
+
+const std::string StringId::s_Empty;
+
+namespace {
+
+// Nodes never move, so the pooled strings keep their address for the
+// lifetime of the process
+struct StringPool {
+  std::shared_mutex Mutex;
+  std::unordered_map<u64, std::string> Strings;
+};
+
+StringPool &GetPool() {
+  // Never destroyed: ids in other statics may outlive this translation unit
+  static StringPool *pool = new StringPool();
+  return *pool;
+}
+
+} // namespace
+
+StringId::StringId(std::string_view str) : m_Hash(HashString(str)) {
+  if (str.empty()) {
+    return;
+  }
+
+  StringPool &pool = GetPool();
+  {
+    std::shared_lock lock(pool.Mutex);
+    auto it = pool.Strings.find(m_Hash);
+    if (it != pool.Strings.end()) {
+      assert(it->second == str && "StringId hash collision");
+      m_String = &it->second;
+      return;
+    }
+  }
+
+  std::unique_lock lock(pool.Mutex);
+  auto [it, inserted] = pool.Strings.try_emplace(m_Hash, str);
+  assert((inserted || it->second == str) && "StringId hash collision");
+  m_String = &it->second;
+}
+
+size_t StringId::GetPoolSize() {
+  StringPool &pool = GetPool();
+  std::shared_lock lock(pool.Mutex);
+  return pool.Strings.size();
+}
+
+} // namespace Horse
@@ -2,6 +2,7 @@
 #include "HorseEngine/Core/FileSystem.h"
 #include "HorseEngine/Core/Input.h"
 #include "HorseEngine/Core/Memory.h"
+#include "HorseEngine/Core/MemoryTracker.h"
 #include "HorseEngine/Game/GameModule.h"
 #include "HorseEngine/Project/Project.h"
 #include "HorseEngine/Render/Renderer.h"
@@ -25,7 +26,9 @@ bool Engine::Initialize(bool headless) {
 
   Time::Initialize();
   FrameAllocator::Initialize();
+  BufferedFrameAllocator::Initialize();
   JobSystem::Initialize();
+  FileSystem::StartAsyncIO();
 
   HORSE_LOG_CORE_INFO("Job System: {} worker threads",
                       JobSystem::GetThreadCount());
@@ -41,6 +44,10 @@ bool Engine::Initialize(bool headless) {
     HORSE_LOG_CORE_INFO("Window initialized");
   } else {
     HORSE_LOG_CORE_INFO("Running in headless mode (no window)");
+
+    // No engine window and so no overlay (the editor and servers drive
+    // frames themselves), so report memory use in the log
+    MemoryTracker::SetReportInterval(60.0);
   }
 
   HORSE_LOG_CORE_INFO("Engine initialized successfully");
@@ -83,7 +90,9 @@ void Engine::Shutdown() {
 
   m_Window.reset();
 
+  FileSystem::StopAsyncIO();
   JobSystem::Shutdown();
+  BufferedFrameAllocator::Shutdown();
   FrameAllocator::Shutdown();
 
   HORSE_LOG_CORE_INFO("Engine shutdown complete");
@@ -91,6 +100,14 @@ void Engine::Shutdown() {
 }
 
 void Engine::Run() {
+  // Headless: no window to pump, frames run until RequestExit
+  if (!m_Window) {
+    while (m_Running) {
+      RunFrame();
+    }
+    return;
+  }
+
   while (m_Running && m_Window->PollEvents()) {
     RunFrame();
   }
@@ -98,15 +115,22 @@ void Engine::Run() {
 
 void Engine::RunFrame() {
   FrameAllocator::Reset();
+  BufferedFrameAllocator::NextFrame();
+  ScratchArena::NewFrame();
   Time::Update();
 
+  // Results handed back to the main thread by background jobs
+  JobSystem::BeginFrame();
+  JobSystem::PumpMainThread();
+  MemoryTracker::Update();
+
   // Update
   if (m_GameModule) {
     m_GameModule->OnUpdate(Time::GetDeltaTime());
   }
 
   // Render
-  if (m_Renderer && m_GameModule) {
+  if (m_Renderer && m_GameModule && m_Window) {
     m_Renderer->BeginFrame();
     m_Renderer->Clear(0.1f, 0.1f, 0.1f, 1.0f);
 
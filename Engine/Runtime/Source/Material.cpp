@@ -5,11 +5,11 @@ namespace Horse {
 MaterialInstance::MaterialInstance(const std::string &name)
     : m_Name(name), m_ShaderName("StandardPBR") {}
 
-void MaterialInstance::SetFloat(const std::string &name, float value) {
+void MaterialInstance::SetFloat(const StringId &name, float value) {
   m_FloatProps[name] = value;
 }
 
-float MaterialInstance::GetFloat(const std::string &name) const {
+float MaterialInstance::GetFloat(const StringId &name) const {
   auto it = m_FloatProps.find(name);
   if (it != m_FloatProps.end()) {
     return it->second;
@@ -17,12 +17,12 @@ float MaterialInstance::GetFloat(const std::string &name) const {
   return 0.0f;
 }
 
-void MaterialInstance::SetColor(const std::string &name,
+void MaterialInstance::SetColor(const StringId &name,
                                 const std::array<float, 4> &value) {
   m_ColorProps[name] = value;
 }
 
-std::array<float, 4> MaterialInstance::GetColor(const std::string &name) const {
+std::array<float, 4> MaterialInstance::GetColor(const StringId &name) const {
   auto it = m_ColorProps.find(name);
   if (it != m_ColorProps.end()) {
     return it->second;
@@ -30,12 +30,12 @@ std::array<float, 4> MaterialInstance::GetColor(const std::string &name) const {
   return {1.0f, 1.0f, 1.0f, 1.0f};
 }
 
-void MaterialInstance::SetTexture(const std::string &name,
+void MaterialInstance::SetTexture(const StringId &name,
                                   const std::string &pathOrAssetID) {
   m_TextureProps[name] = pathOrAssetID;
 }
 
-std::string MaterialInstance::GetTexture(const std::string &name) const {
+std::string MaterialInstance::GetTexture(const StringId &name) const {
   auto it = m_TextureProps.find(name);
   if (it != m_TextureProps.end()) {
     return it->second;
@@ -43,7 +43,7 @@ std::string MaterialInstance::GetTexture(const std::string &name) const {
   return "";
 }
 
-bool MaterialInstance::HasTexture(const std::string &name) const {
+bool MaterialInstance::HasTexture(const StringId &name) const {
   return m_TextureProps.find(name) != m_TextureProps.end();
 }
 
@@ -1,11 +1,20 @@
 #include "HorseEngine/Render/MaterialRegistry.h"
 #include "HorseEngine/Asset/AssetManager.h"
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Memory.h"
 #include "HorseEngine/Render/MaterialSerializer.h"
 #include <filesystem>
 
 namespace Horse {
 
+static const StringId s_DefaultName("Default");
+
+// Instances and their control blocks come from a pool
+static std::shared_ptr<MaterialInstance> NewMaterial(const std::string &name) {
+  return std::allocate_shared<MaterialInstance>(
+      PoolStlAllocator<MaterialInstance>(), name);
+}
+
 MaterialRegistry &MaterialRegistry::Get() {
   static MaterialRegistry instance;
   return instance;
@@ -13,33 +22,36 @@ MaterialRegistry &MaterialRegistry::Get() {
 
 MaterialRegistry::MaterialRegistry() {
   // Create Default Material
-  auto defaultMat = std::make_shared<MaterialInstance>("Default");
+  auto defaultMat = NewMaterial("Default");
   defaultMat->SetColor("Albedo", {1.0f, 1.0f, 1.0f, 1.0f});
   defaultMat->SetFloat("Roughness", 0.5f);
   defaultMat->SetFloat("Metalness", 0.0f);
-  m_Materials["Default"] = defaultMat;
+  m_Materials[s_DefaultName] = defaultMat;
 }
 
 std::shared_ptr<MaterialInstance>
-MaterialRegistry::GetMaterial(const std::string &nameOrGuid) {
+MaterialRegistry::GetMaterial(const StringId &nameOrGuid) {
   auto it = m_Materials.find(nameOrGuid);
   if (it != m_Materials.end()) {
     return it->second;
   }
+  if (nameOrGuid.IsEmpty()) {
+    return m_Materials[s_DefaultName];
+  }
 
   // If not found by name, try to treat as GUID and load via AssetManager
   try {
     UUID guid(0);
     try {
-      guid = UUID(std::stoull(nameOrGuid));
+      guid = UUID(std::stoull(nameOrGuid.GetString()));
     } catch (...) {
       // Not a numeric GUID, try friendly name via AssetManager
       auto &am = AssetManager::Get();
-      guid = am.GetHandleByFriendlyName(nameOrGuid);
+      guid = am.GetHandleByFriendlyName(nameOrGuid.GetString());
       if (static_cast<u64>(guid) != 0) {
         HORSE_LOG_CORE_INFO("MaterialRegistry: Resolved friendly name '{0}' to "
                             "GUID {1}",
-                            nameOrGuid, static_cast<u64>(guid));
+                            nameOrGuid.GetString(), static_cast<u64>(guid));
       }
     }
 
@@ -66,7 +78,7 @@ MaterialRegistry::GetMaterial(const std::string &nameOrGuid) {
   } catch (...) {
   }
 
-  return m_Materials["Default"];
+  return m_Materials[s_DefaultName];
 }
 
 std::shared_ptr<MaterialInstance>
@@ -77,7 +89,7 @@ MaterialRegistry::CreateMaterial(const std::string &name) {
     return m_Materials[name];
   }
 
-  auto newMat = std::make_shared<MaterialInstance>(name);
+  auto newMat = NewMaterial(name);
   // Default values
   newMat->SetColor("Albedo", {1.0f, 1.0f, 1.0f, 1.0f});
   newMat->SetFloat("Roughness", 0.5f);
@@ -89,7 +101,7 @@ MaterialRegistry::CreateMaterial(const std::string &name) {
 
 std::shared_ptr<MaterialInstance>
 MaterialRegistry::LoadMaterial(const std::string &filepath) {
-  auto material = std::make_shared<MaterialInstance>("Temp");
+  auto material = NewMaterial("Temp");
   if (MaterialSerializer::Deserialize(filepath, *material)) {
     material->SetFilePath(filepath);
 
@@ -14,19 +14,19 @@ bool MaterialSerializer::Serialize(const MaterialInstance &material,
 
   nlohmann::json floatProps = nlohmann::json::object();
   for (const auto &[name, value] : material.GetFloatProperties()) {
-    floatProps[name] = value;
+    floatProps[name.GetString()] = value;
   }
   out["FloatProperties"] = floatProps;
 
   nlohmann::json colorProps = nlohmann::json::object();
   for (const auto &[name, value] : material.GetColorProperties()) {
-    colorProps[name] = value;
+    colorProps[name.GetString()] = value;
   }
   out["ColorProperties"] = colorProps;
 
   nlohmann::json texProps = nlohmann::json::object();
   for (const auto &[name, value] : material.GetTextureProperties()) {
-    texProps[name] = value;
+    texProps[name.GetString()] = value;
   }
   out["TextureProperties"] = texProps;
 
@@ -42,8 +42,8 @@ bool MaterialSerializer::Serialize(const MaterialInstance &material,
 
 bool MaterialSerializer::Deserialize(const std::string &filepath,
                                      MaterialInstance &output) {
-  std::vector<uint8_t> data;
-  if (!FileSystem::ReadBytes(filepath, data)) {
+  MappedFile data = FileSystem::Map(filepath);
+  if (!data) {
     HORSE_LOG_CORE_ERROR("Could not open file for reading: {0}", filepath);
     return false;
   }
@@ -51,7 +51,8 @@ bool MaterialSerializer::Deserialize(const std::string &filepath,
   if (data.empty())
     return false;
 
-  std::string jsonContent;
+  // Parsed in place from the mapped file
+  std::string_view jsonContent;
 
   // Check for Cooked Header
   if (data.size() >= sizeof(MaterialCookedHeader)) {
@@ -68,8 +69,7 @@ bool MaterialSerializer::Deserialize(const std::string &filepath,
         offset += sizeof(uint32_t);
 
         if (data.size() >= offset + jsonSize) {
-          jsonContent.assign(
-              reinterpret_cast<const char *>(data.data() + offset), jsonSize);
+          jsonContent = data.GetText().substr(offset, jsonSize);
           HORSE_LOG_CORE_INFO(
               "MaterialSerializer: Extracted JSON segment ({0} bytes)",
               jsonSize);
@@ -86,8 +86,7 @@ bool MaterialSerializer::Deserialize(const std::string &filepath,
   if (jsonContent.empty()) {
     HORSE_LOG_CORE_INFO("MaterialSerializer: Treating {0} as raw JSON",
                         filepath);
-    jsonContent.assign(reinterpret_cast<const char *>(data.data()),
-                       data.size());
+    jsonContent = data.GetText();
   }
 
   nlohmann::json j;
@@ -1,4 +1,5 @@
 #include "HorseEngine/Core/Input.h"
+#include "HorseEngine/Core/FlatHashMap.h"
 #include "HorseEngine/Core/Logging.h"
 #include <string>
 #include <unordered_map>
@@ -6,8 +7,8 @@
 
 namespace Horse {
 
-static std::unordered_map<int, bool> s_KeyStates;
-static std::unordered_map<int, bool> s_MouseStates;
+static FlatHashMap<int, bool> s_KeyStates;
+static FlatHashMap<int, bool> s_MouseStates;
 static float s_MouseX = 0.0f;
 static float s_MouseY = 0.0f;
 
@@ -37,7 +38,7 @@ void Input::RegisterAction(const std::string &name,
                            const std::vector<int> &keys) {
   HORSE_LOG_CORE_INFO("Input: RegisterAction: {} (ActionsAddr: {})", name,
                       (void *)&s_Actions);
-  s_Actions[name] = {name, keys};
+  s_Actions[name] = {name, {keys.begin(), keys.end()}};
 }
 
 void Input::RegisterAxis(const std::string &name,
@@ -45,7 +46,9 @@ void Input::RegisterAxis(const std::string &name,
                          const std::vector<int> &negativeKeys) {
   HORSE_LOG_CORE_INFO("Input: RegisterAxis: {} (AxesAddr: {})", name,
                       (void *)&s_Axes);
-  s_Axes[name] = {name, positiveKeys, negativeKeys};
+  s_Axes[name] = {name,
+                  {positiveKeys.begin(), positiveKeys.end()},
+                  {negativeKeys.begin(), negativeKeys.end()}};
 }
 
 bool Input::IsActionPressed(const std::string &name) {
@@ -69,8 +69,8 @@ struct ProjectCookedHeader {
 
 std::shared_ptr<Project>
 Project::LoadFromBinary(const std::filesystem::path &path) {
-  std::vector<uint8_t> data;
-  if (!FileSystem::ReadBytes(path, data))
+  MappedFile data = FileSystem::Map(path);
+  if (!data)
     return nullptr;
 
   if (data.size() < sizeof(ProjectCookedHeader))
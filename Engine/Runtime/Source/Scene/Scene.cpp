@@ -1,8 +1,10 @@
 #include "HorseEngine/Scene/Scene.h"
 #include "HorseEngine/Core/Input.h"
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Memory.h"
 #include "HorseEngine/Physics/PhysicsSystem.h"
 #include "HorseEngine/Scene/Components.h"
+#include "HorseEngine/Scene/ParallelView.h"
 #include "HorseEngine/Scene/SceneSerializer.h"
 #include "HorseEngine/Scene/ScriptableEntity.h"
 #include "HorseEngine/Scripting/LuaScriptEngine.h"
@@ -22,14 +24,18 @@ std::shared_ptr<Scene> Scene::Copy(const std::shared_ptr<Scene> &other) {
 }
 
 Scene::Scene(const std::string &name) : m_Name(name) {
-  m_PhysicsSystem = new PhysicsSystem();
+  // Pooled: scene copies are made and dropped on every play/stop
+  m_PhysicsSystem = PoolAllocator<PhysicsSystem>::Shared().New();
   m_PhysicsSystem->Initialize();
 }
 
 Scene::~Scene() {
+  // Script loads still in flight must not call back into this scene
+  LuaScriptEngine::OnDestroyScene(this);
+
   if (m_PhysicsSystem) {
     m_PhysicsSystem->Shutdown();
-    delete m_PhysicsSystem;
+    PoolAllocator<PhysicsSystem>::Shared().Delete(m_PhysicsSystem);
     m_PhysicsSystem = nullptr;
   }
 }
@@ -62,12 +68,8 @@ void Scene::DestroyEntity(Entity entity) {
     RemoveParent(entity);
   }
 
-  // Find and remove from entity map
-  for (auto it = m_EntityMap.begin(); it != m_EntityMap.end(); ++it) {
-    if (it->second == entity.GetHandle()) {
-      m_EntityMap.erase(it);
-      break;
-    }
+  if (entity.HasComponent<UUIDComponent>()) {
+    m_EntityMap.erase(entity.GetComponent<UUIDComponent>().ID);
   }
 
   m_Registry.destroy(entity.GetHandle());
@@ -81,7 +83,7 @@ Entity Scene::GetEntityByUUID(UUID uuid) {
   return {};
 }
 
-Entity Scene::GetEntityByName(const std::string &name) {
+Entity Scene::GetEntityByName(const StringId &name) {
   auto view = m_Registry.view<TagComponent>();
   for (auto entity : view) {
     const auto &tag = view.get<TagComponent>(entity);
@@ -191,10 +193,10 @@ void Scene::TriggerAssetLoads() {
   auto view = m_Registry.view<MeshRendererComponent>();
   for (auto entity : view) {
     auto &mesh = view.get<MeshRendererComponent>(entity);
-    if (!mesh.MeshGUID.empty()) {
+    if (!mesh.MeshGUID.IsEmpty()) {
       m_LoadingQueue.push_back(mesh.MeshGUID);
     }
-    if (!mesh.MaterialGUID.empty()) {
+    if (!mesh.MaterialGUID.IsEmpty()) {
       m_LoadingQueue.push_back(mesh.MaterialGUID);
     }
   }
@@ -232,8 +234,9 @@ void Scene::UpdateStagedLoad() {
       for (auto entity : view) {
         auto &script = view.get<ScriptComponent>(entity);
         if (!script.AwakeCalled) {
-          HORSE_LOG_CORE_INFO("Awaking entity {}...",
-                              m_Registry.get<TagComponent>(entity).Name);
+          HORSE_LOG_CORE_INFO(
+              "Awaking entity {}...",
+              m_Registry.get<TagComponent>(entity).Name.GetString());
           script.AwakeCalled = true;
           LuaScriptEngine::OnCreateEntity({entity, this});
         }
@@ -246,8 +249,9 @@ void Scene::UpdateStagedLoad() {
       for (auto entity : view) {
         auto &script = view.get<ScriptComponent>(entity);
         if (!script.StartCalled) {
-          HORSE_LOG_CORE_INFO("Starting entity {}...",
-                              m_Registry.get<TagComponent>(entity).Name);
+          HORSE_LOG_CORE_INFO(
+              "Starting entity {}...",
+              m_Registry.get<TagComponent>(entity).Name.GetString());
           script.StartCalled = true;
           // TODO: ScriptEngine::OnStart(entity)
         }
@@ -354,14 +358,15 @@ void Scene::OnUpdate(float deltaTime) {
 }
 
 void Scene::UpdateTransformHierarchy() {
+  // Every root owns a disjoint subtree, so roots are updated in parallel
   auto view = m_Registry.view<TransformComponent, RelationshipComponent>();
-  for (auto entity : view) {
+  ParallelForEach(view, [this, &view](entt::entity entity) {
     auto &relationship = view.get<RelationshipComponent>(entity);
     // Find roots (entities with no parent)
     if (relationship.Parent == entt::null) {
       UpdateEntityTransform({entity, this}, glm::mat4(1.0f));
     }
-  }
+  });
 }
 
 void Scene::UpdateEntityTransform(Entity entity,
@@ -1,6 +1,7 @@
 #include "HorseEngine/Scene/SceneSerializer.h"
 #include "HorseEngine/Core/FileSystem.h"
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Memory.h"
 #include "HorseEngine/Engine.h"
 #include "HorseEngine/Scene/Components.h"
 #include "HorseEngine/Scene/Entity.h"
@@ -16,7 +17,7 @@ namespace Horse {
 
 // Helper functions for component serialization
 static json SerializeTagComponent(const TagComponent &comp) {
-  return {{"name", comp.Name}, {"tag", comp.Tag}};
+  return {{"name", comp.Name.GetString()}, {"tag", comp.Tag.GetString()}};
 }
 
 static void DeserializeTagComponent(const json &j, TagComponent &comp) {
@@ -129,7 +130,8 @@ static void DeserializeLightComponent(const json &j, LightComponent &comp) {
 }
 
 static json SerializeMeshRendererComponent(const MeshRendererComponent &comp) {
-  return {{"meshGuid", comp.MeshGUID}, {"materialGuid", comp.MaterialGUID}};
+  return {{"meshGuid", comp.MeshGUID.GetString()},
+          {"materialGuid", comp.MaterialGUID.GetString()}};
 }
 
 static void DeserializeMeshRendererComponent(const json &j,
@@ -271,26 +273,44 @@ static json SerializeSceneToJson(const Scene *scene) {
   return sceneJson;
 }
 
+// Temporary memory for loading. Loads nest (a scene copy, a script loading
+// another scene) and free in order, so a stack per thread is enough.
+static StackAllocator &GetLoadStack() {
+  thread_local StackAllocator stack(32 * 1024 * 1024);
+  return stack;
+}
+
 static std::shared_ptr<Scene> DeserializeSceneFromJson(const json &sceneJson) {
   // Create scene
   std::string sceneName = sceneJson.value("name", "Untitled Scene");
   auto scene = std::make_shared<Scene>(sceneName);
 
-  // First pass: Create all entities with UUIDs
-  std::unordered_map<UUID, entt::entity> uuidToEntity;
+  // Entity handles in file order, on the load stack
+  StackAllocator &stack = GetLoadStack();
+  StackScope scope(stack);
+  const auto &entitiesJson = sceneJson["entities"];
+  entt::entity *handles =
+      stack.AllocateArray<entt::entity>(entitiesJson.size());
+  if (!handles && !entitiesJson.empty()) {
+    HORSE_LOG_CORE_ERROR("Scene '{}' has too many entities to load",
+                         sceneName);
+    return nullptr;
+  }
 
-  for (const auto &entityJson : sceneJson["entities"]) {
+  // First pass: Create all entities with UUIDs
+  size_t index = 0;
+  for (const auto &entityJson : entitiesJson) {
     UUID uuid(std::stoull(entityJson["uuid"].get<std::string>()));
 
     // Create entity with specific UUID
     auto entity = scene->CreateEntityWithUUID(uuid, "Temp");
-    uuidToEntity[uuid] = entity.GetHandle();
+    handles[index++] = entity.GetHandle();
   }
 
   // Second pass: Deserialize components
-  for (const auto &entityJson : sceneJson["entities"]) {
-    UUID uuid(std::stoull(entityJson["uuid"].get<std::string>()));
-    Entity entity(uuidToEntity[uuid], scene.get());
+  index = 0;
+  for (const auto &entityJson : entitiesJson) {
+    Entity entity(handles[index++], scene.get());
 
     if (!entityJson.contains("components"))
       continue;
@@ -367,20 +387,18 @@ static std::shared_ptr<Scene> DeserializeSceneFromJson(const json &sceneJson) {
   }
 
   // Third pass: Restore relationships
-  for (const auto &entityJson : sceneJson["entities"]) {
+  index = 0;
+  for (const auto &entityJson : entitiesJson) {
+    Entity entity(handles[index++], scene.get());
     if (!entityJson["components"].contains("RelationshipComponent"))
       continue;
 
-    UUID uuid(std::stoull(entityJson["uuid"].get<std::string>()));
-    Entity entity(uuidToEntity[uuid], scene.get());
-
     const auto &relJson = entityJson["components"]["RelationshipComponent"];
 
     // Restore parent relationship
     if (!relJson["parent"].is_null()) {
       UUID parentUUID(std::stoull(relJson["parent"].get<std::string>()));
-      if (uuidToEntity.find(parentUUID) != uuidToEntity.end()) {
-        Entity parent(uuidToEntity[parentUUID], scene.get());
+      if (Entity parent = scene->GetEntityByUUID(parentUUID)) {
         scene->SetEntityParent(entity, parent);
       }
     }
@@ -435,24 +453,27 @@ std::string SceneSerializer::SerializeToJSONString(const Scene *scene) {
 std::shared_ptr<Scene>
 SceneSerializer::DeserializeFromJSON(const std::string &filepath) {
   try {
-    std::string jsonContent;
-    if (!FileSystem::ReadText(filepath, jsonContent)) {
+    std::unique_ptr<FileStream> stream = FileSystem::OpenStream(filepath);
+    if (!stream) {
       HORSE_LOG_CORE_ERROR("Failed to open file for reading: {}", filepath);
       return nullptr;
     }
 
     // Check for HLVL header (Cooked Level)
-    if (jsonContent.size() >= 4 && jsonContent.substr(0, 4) == "HLVL") {
-      if (jsonContent.size() >= 16) {
-        // Skip Header (12 bytes) + Size (4 bytes) = 16 bytes
-        jsonContent = jsonContent.substr(16);
-      } else {
+    char magic[4] = {};
+    if (stream->Read(magic, sizeof(magic)) == sizeof(magic) &&
+        std::string_view(magic, sizeof(magic)) == "HLVL") {
+      // Skip Header (12 bytes) + Size (4 bytes) = 16 bytes
+      if (!stream->Seek(16)) {
         HORSE_LOG_CORE_ERROR("Corrupt cooked level file: {}", filepath);
         return nullptr;
       }
+    } else {
+      stream->Seek(0);
     }
 
-    json sceneJson = json::parse(jsonContent);
+    // Parsed chunk by chunk, the whole file is never in memory
+    json sceneJson = json::parse(stream->begin(), stream->end());
     // ... rest is same
     auto scene = DeserializeSceneFromJson(sceneJson);
     HORSE_LOG_CORE_INFO("Scene deserialized successfully from: {}", filepath);
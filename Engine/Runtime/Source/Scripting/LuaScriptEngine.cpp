@@ -2,6 +2,7 @@
 #include "HorseEngine/Core/FileSystem.h"
 #include "HorseEngine/Core/Input.h"
 #include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/MemoryTracker.h"
 #include "HorseEngine/Project/Project.h"
 #include "HorseEngine/Scene/Components.h"
 #include "HorseEngine/Scene/Scene.h"
@@ -11,9 +12,29 @@ namespace Horse {
 
 sol::state *LuaScriptEngine::s_LuaState = nullptr;
 std::unordered_map<UUID, sol::table> LuaScriptEngine::s_ScriptInstances;
+std::unordered_map<UUID, LuaScriptEngine::PendingScript>
+    LuaScriptEngine::s_PendingScripts;
+
+// lua_Alloc charging script memory to the Script tag
+static void *TrackedLuaAlloc(void *, void *ptr, size_t, size_t nsize) {
+  if (nsize == 0) {
+    MemoryTracker::Free(ptr);
+    return nullptr;
+  }
+  return MemoryTracker::Reallocate(ptr, nsize, MemoryTag::Script);
+}
 
 void LuaScriptEngine::Init() {
-  s_LuaState = new sol::state();
+  // 64-bit LuaJIT without GC64 only runs on its own allocator and refuses
+  // custom ones, so probe before handing the allocator to sol
+  if (lua_State *probe = lua_newstate(TrackedLuaAlloc, nullptr)) {
+    lua_close(probe);
+    s_LuaState = new sol::state(sol::default_at_panic, TrackedLuaAlloc);
+  } else {
+    HORSE_LOG_CORE_WARN("Lua does not accept a custom allocator, script "
+                        "memory will not be tracked");
+    s_LuaState = new sol::state();
+  }
   s_LuaState->open_libraries(sol::lib::base, sol::lib::package, sol::lib::math,
                              sol::lib::table);
 
@@ -104,7 +125,9 @@ void LuaScriptEngine::BindEntity() {
   horse.new_usertype<Entity>(
       "Entity", "HasTransform", &Entity::HasComponent<TransformComponent>,
       "GetTransform", &Entity::GetComponent<TransformComponent>, "GetName",
-      [](Entity &e) { return e.GetComponent<TagComponent>().Name; });
+      [](Entity &e) -> const std::string & {
+        return e.GetComponent<TagComponent>().Name.GetString();
+      });
 }
 
 void LuaScriptEngine::OnCreateEntity(Entity entity) {
@@ -115,6 +138,10 @@ void LuaScriptEngine::OnCreateEntity(Entity entity) {
   if (sc.ScriptPath.empty())
     return;
 
+  const UUID id = entity.GetUUID();
+  if (s_PendingScripts.contains(id))
+    return;
+
   namespace fs = std::filesystem;
   fs::path scriptPath = sc.ScriptPath;
 
@@ -133,19 +160,49 @@ void LuaScriptEngine::OnCreateEntity(Entity entity) {
     return;
   }
 
-  // Read script content via FileSystem (supports PAK files)
-  std::string scriptContent;
-  if (!FileSystem::ReadText(scriptPath, scriptContent)) {
-    HORSE_LOG_CORE_ERROR("Failed to read Lua script: {}", scriptPath.string());
-    return;
+  // Read off the frame (supports PAK files). Without the I/O threads the
+  // callback runs before ReadBytesAsync returns, so register first.
+  s_PendingScripts[id] = {entity.GetScene(), scriptPath, 0};
+  const FileRequestID request = FileSystem::ReadBytesAsync(
+      scriptPath, JobPriority::Normal,
+      [id](bool success, const ByteBuffer &data) {
+        auto it = s_PendingScripts.find(id);
+        if (it == s_PendingScripts.end())
+          return; // Entity destroyed meanwhile
+        PendingScript pending = std::move(it->second);
+        s_PendingScripts.erase(it);
+
+        if (!success) {
+          HORSE_LOG_CORE_ERROR("Failed to read Lua script: {}",
+                               pending.Path.string());
+          return;
+        }
+        // The entity may have been destroyed while the file was read
+        Entity owner = pending.Owner->GetEntityByUUID(id);
+        if (!owner)
+          return;
+        RunScript(owner, pending.Path,
+                  {reinterpret_cast<const char *>(data.data()), data.size()});
+      });
+
+  auto it = s_PendingScripts.find(id);
+  if (it != s_PendingScripts.end()) {
+    it->second.Request = request;
   }
+}
 
-  // Execute script from string instead of file
-  auto result = s_LuaState->script(scriptContent, sol::script_pass_on_error);
+void LuaScriptEngine::RunScript(Entity entity,
+                                const std::filesystem::path &path,
+                                std::string_view source) {
+  if (!s_LuaState)
+    return;
+
+  // Execute script from memory instead of file
+  auto result = s_LuaState->script(source, sol::script_pass_on_error);
   if (!result.valid()) {
     sol::error err = result;
-    HORSE_LOG_CORE_ERROR("Failed to load Lua script {}: {}",
-                         scriptPath.string(), err.what());
+    HORSE_LOG_CORE_ERROR("Failed to load Lua script {}: {}", path.string(),
+                         err.what());
     return;
   }
 
@@ -160,6 +217,9 @@ void LuaScriptEngine::OnCreateEntity(Entity entity) {
 void LuaScriptEngine::OnUpdateEntity(Entity entity, float deltaTime) {
   UUID id = entity.GetUUID();
   if (s_ScriptInstances.find(id) == s_ScriptInstances.end()) {
+    // Still loading
+    if (s_PendingScripts.contains(id))
+      return;
     // Try to initialize if not cached (might happen on hot-reload or load)
     OnCreateEntity(entity);
     if (s_ScriptInstances.find(id) == s_ScriptInstances.end())
@@ -178,6 +238,23 @@ void LuaScriptEngine::OnUpdateEntity(Entity entity, float deltaTime) {
 
 void LuaScriptEngine::OnDestroyEntity(Entity entity) {
   s_ScriptInstances.erase(entity.GetUUID());
+
+  auto it = s_PendingScripts.find(entity.GetUUID());
+  if (it != s_PendingScripts.end()) {
+    FileSystem::CancelRead(it->second.Request);
+    s_PendingScripts.erase(it);
+  }
+}
+
+void LuaScriptEngine::OnDestroyScene(Scene *scene) {
+  for (auto it = s_PendingScripts.begin(); it != s_PendingScripts.end();) {
+    if (it->second.Owner == scene) {
+      FileSystem::CancelRead(it->second.Request);
+      it = s_PendingScripts.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 } // namespace Horse
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Horse {
+
+struct BenchmarkOptions {
+  unsigned MaxThreads = 0; // 0 = hardware concurrency
+  unsigned Iterations = 5;
+  std::string PakPath;         // Existing archive for "pak", else generated
+  bool PakPhysFSFirst = false; // Which reader "pak" runs first
+};
+
+// Each benchmark prints its own result table to stdout
+void RunJobSystemBenchmark(const BenchmarkOptions &options);
+void RunJobAllocationBenchmark(const BenchmarkOptions &options);
+void RunSceneBenchmark(const BenchmarkOptions &options);
+void RunContainerBenchmark(const BenchmarkOptions &options);
+void RunPakBenchmark(const BenchmarkOptions &options);
+
+} // namespace Horse
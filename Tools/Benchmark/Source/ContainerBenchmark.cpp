@@ -0,0 +1,149 @@
+#include "Benchmarks.h"
+#include "HorseEngine/Core/FlatHashMap.h"
+#include "HorseEngine/Core/FlatMap.h"
+#include "HorseEngine/Core/SmallVector.h"
+#include "HorseEngine/Core/StringId.h"
+#include "HorseEngine/Scene/UUID.h"
+
+#include <chrono>
+#include <fmt/format.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Horse {
+
+static constexpr u32 LookupsPerIteration = 1000000;
+static constexpr u32 EntityCount = 10000;
+
+// Keeps the optimizer from dropping the lookups
+static volatile u64 s_Sink = 0;
+
+template <typename Lookup>
+static double NanosecondsPerLookup(u32 iterations, Lookup &&lookup) {
+  u64 sum = lookup(); // Warm up caches
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 it = 0; it < iterations; ++it) {
+    sum += lookup();
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  s_Sink = s_Sink + sum;
+  return seconds * 1e9 / ((double)LookupsPerIteration * iterations);
+}
+
+static void PrintRow(const char *workload, const char *container, double ns) {
+  fmt::print("{:>18} {:>36} {:>10.2f}\n", workload, container, ns);
+}
+
+// Scene::GetEntityByUUID: random hits over every entity of a level
+template <typename Map>
+static double MeasureEntityLookup(u32 iterations,
+                                  const std::vector<UUID> &uuids) {
+  Map map;
+  for (u32 i = 0; i < EntityCount; ++i) {
+    map[uuids[i]] = i;
+  }
+  std::vector<u32> order(LookupsPerIteration);
+  std::mt19937 rng(7);
+  for (u32 &index : order) {
+    index = rng() % EntityCount;
+  }
+  return NanosecondsPerLookup(iterations, [&]() {
+    u64 sum = 0;
+    for (u32 index : order) {
+      sum += map.find(uuids[index])->second;
+    }
+    return sum;
+  });
+}
+
+// Input::IsKeyPressed: a few dozen keys ever pressed, polled every frame
+template <typename Map> static double MeasureKeyStates(u32 iterations) {
+  Map map;
+  for (int key = 0x08; key < 0x5B; key += 2) {
+    map[key] = (key & 4) != 0;
+  }
+  return NanosecondsPerLookup(iterations, [&]() {
+    u64 sum = 0;
+    for (u32 i = 0; i < LookupsPerIteration; ++i) {
+      auto it = map.find(static_cast<int>(i & 0x7F));
+      sum += (it != map.end() && it->second) ? 1 : 0;
+    }
+    return sum;
+  });
+}
+
+// MaterialInstance::GetFloat/GetColor: a handful of properties per draw
+template <typename Map, typename Key>
+static double MeasureMaterialProperties(u32 iterations,
+                                        const std::vector<Key> &names) {
+  Map map;
+  for (size_t i = 0; i < names.size(); ++i) {
+    map[names[i]] = static_cast<float>(i);
+  }
+  return NanosecondsPerLookup(iterations, [&]() {
+    u64 sum = 0;
+    for (u32 i = 0; i < LookupsPerIteration; ++i) {
+      sum += static_cast<u64>(map.find(names[i % names.size()])->second);
+    }
+    return sum;
+  });
+}
+
+// ActionMapping keys: build a short list, then scan it
+template <typename Vector> static double MeasureKeyList(u32 iterations) {
+  return NanosecondsPerLookup(iterations, [&]() {
+    u64 sum = 0;
+    for (u32 i = 0; i < LookupsPerIteration / 4; ++i) {
+      Vector keys;
+      for (int key = 0; key < 3; ++key) {
+        keys.push_back(static_cast<int>(i) + key);
+      }
+      for (int key : keys) {
+        sum += static_cast<u64>(key);
+      }
+    }
+    return sum;
+  });
+}
+
+void RunContainerBenchmark(const BenchmarkOptions &options) {
+  const u32 iterations = options.Iterations;
+
+  std::vector<UUID> uuids(EntityCount);
+  const std::vector<std::string> names = {
+      "Albedo", "Roughness", "Metalness", "Emission", "Opacity", "AlbedoMap"};
+  const std::vector<StringId> ids(names.begin(), names.end());
+
+  fmt::print("{:>18} {:>36} {:>10}\n", "workload", "container", "ns/op");
+  PrintRow("entity by UUID", "std::unordered_map<UUID, u32>",
+           MeasureEntityLookup<std::unordered_map<UUID, u32>>(iterations,
+                                                              uuids));
+  PrintRow("entity by UUID", "FlatHashMap<UUID, u32>",
+           MeasureEntityLookup<FlatHashMap<UUID, u32>>(iterations, uuids));
+
+  PrintRow("key state", "std::unordered_map<int, bool>",
+           MeasureKeyStates<std::unordered_map<int, bool>>(iterations));
+  PrintRow("key state", "FlatHashMap<int, bool>",
+           MeasureKeyStates<FlatHashMap<int, bool>>(iterations));
+
+  PrintRow("material property", "std::unordered_map<string, float>",
+           MeasureMaterialProperties<std::unordered_map<std::string, float>>(
+               iterations, names));
+  PrintRow("material property", "std::unordered_map<StringId, float>",
+           MeasureMaterialProperties<std::unordered_map<StringId, float>>(
+               iterations, ids));
+  PrintRow("material property", "FlatMap<StringId, float>",
+           MeasureMaterialProperties<FlatMap<StringId, float>>(iterations,
+                                                               ids));
+
+  PrintRow("key list", "std::vector<int>",
+           MeasureKeyList<std::vector<int>>(iterations));
+  PrintRow("key list", "SmallVector<int, 4>",
+           MeasureKeyList<SmallVector<int, 4>>(iterations));
+}
+
+} // namespace Horse
@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+#include "HorseEngine/Core/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fmt/format.h>
+#include <thread>
+#include <vector>
+
+namespace Horse {
+
+static constexpr u32 JobsPerIteration = 100000;
+static constexpr u32 FanOutRoots = 64;
+
+// Roughly a few hundred nanoseconds of work, the size of a typical small
+// per-frame job
+static void SmallWork(std::atomic<u64> &sink, u32 seed) {
+  u32 value = seed;
+  for (u32 i = 0; i < 64; ++i) {
+    value = value * 1664525u + 1013904223u;
+  }
+  sink.fetch_add(value & 1, std::memory_order_relaxed);
+}
+
+static double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+// Every job submitted from the main thread (injection queue path)
+static double RunExternal(u32 iterations) {
+  std::atomic<u64> sink{0};
+  auto start = std::chrono::steady_clock::now();
+  for (u32 it = 0; it < iterations; ++it) {
+    for (u32 i = 0; i < JobsPerIteration; ++i) {
+      JobSystem::Execute([&sink, i]() { SmallWork(sink, i); });
+    }
+    JobSystem::WaitAll();
+  }
+  return (double)JobsPerIteration * iterations / Seconds(start);
+}
+
+// A few root jobs fan out from worker threads (local deque + stealing path)
+static double RunFanOut(u32 iterations) {
+  std::atomic<u64> sink{0};
+  auto start = std::chrono::steady_clock::now();
+  for (u32 it = 0; it < iterations; ++it) {
+    for (u32 root = 0; root < FanOutRoots; ++root) {
+      JobSystem::Execute([&sink]() {
+        for (u32 i = 0; i < JobsPerIteration / FanOutRoots; ++i) {
+          JobSystem::Execute([&sink, i]() { SmallWork(sink, i); });
+        }
+      });
+    }
+    JobSystem::WaitAll();
+  }
+  u32 jobs = FanOutRoots + (JobsPerIteration / FanOutRoots) * FanOutRoots;
+  return (double)jobs * iterations / Seconds(start);
+}
+
+void RunJobSystemBenchmark(const BenchmarkOptions &options) {
+  u32 maxThreads = options.MaxThreads;
+  if (maxThreads == 0) {
+    maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  fmt::print("{:>8} {:>16} {:>16} {:>10}\n", "threads", "external/s",
+             "fan-out/s", "scaling");
+
+  // Powers of two up to, and always including, maxThreads
+  std::vector<u32> threadCounts;
+  for (u32 threads = 1; threads < maxThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+
+  double baseline = 0.0;
+  for (u32 threads : threadCounts) {
+    JobSystem::Initialize(threads);
+
+    // Warm up thread start-up and allocator caches
+    RunExternal(1);
+
+    double external = RunExternal(options.Iterations);
+    double fanOut = RunFanOut(options.Iterations);
+    if (threads == 1) {
+      baseline = fanOut;
+    }
+
+    fmt::print("{:>8} {:>16.0f} {:>16.0f} {:>9.2f}x\n", threads, external,
+               fanOut, baseline > 0.0 ? fanOut / baseline : 0.0);
+
+    JobSystem::Shutdown();
+  }
+}
+
+} // namespace Horse
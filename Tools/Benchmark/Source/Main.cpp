@@ -0,0 +1,91 @@
+#include "Benchmarks.h"
+#include "HorseEngine/Core/Logging.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Horse;
+
+struct BenchmarkEntry {
+  const char *Name;
+  const char *Description;
+  void (*Run)(const BenchmarkOptions &);
+};
+
+static const BenchmarkEntry s_Benchmarks[] = {
+    {"jobs", "JobSystem throughput (jobs/sec) from 1 to N worker threads",
+     &RunJobSystemBenchmark},
+    {"joballoc",
+     "Job submission cost: std::function/std::future vs pooled inline jobs",
+     &RunJobAllocationBenchmark},
+    {"scene",
+     "Scene load and per-frame update, to compare heaps (HORSE_USE_MIMALLOC)",
+     &RunSceneBenchmark},
+    {"containers",
+     "Lookup-heavy workloads: std containers vs FlatHashMap/FlatMap/"
+     "SmallVector",
+     &RunContainerBenchmark},
+    {"pak", "Game.pak mount and read time: PhysFS vs PakReader",
+     &RunPakBenchmark},
+};
+
+void PrintUsage() {
+  std::cout << "Usage: HorseBenchmark [benchmark...] [--threads N] "
+               "[--iterations N] [--pak FILE] [--pak-first physfs|pakreader]"
+            << std::endl;
+  std::cout << "Available benchmarks:" << std::endl;
+  for (const auto &entry : s_Benchmarks) {
+    std::cout << "  " << entry.Name << " - " << entry.Description
+              << std::endl;
+  }
+}
+
+int main(int argc, char **argv) {
+  BenchmarkOptions options;
+  std::vector<std::string> selected;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      options.MaxThreads = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      options.Iterations = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (strcmp(argv[i], "--pak") == 0 && i + 1 < argc) {
+      options.PakPath = argv[++i];
+    } else if (strcmp(argv[i], "--pak-first") == 0 && i + 1 < argc) {
+      options.PakPhysFSFirst = strcmp(argv[++i], "physfs") == 0;
+    } else if (strcmp(argv[i], "--help") == 0) {
+      PrintUsage();
+      return 0;
+    } else {
+      selected.push_back(argv[i]);
+    }
+  }
+
+  Logger::Initialize();
+
+  bool ranAny = false;
+  for (const auto &entry : s_Benchmarks) {
+    bool wanted = selected.empty();
+    for (const auto &name : selected) {
+      wanted |= (name == entry.Name);
+    }
+    if (!wanted)
+      continue;
+
+    std::cout << "== " << entry.Name << ": " << entry.Description
+              << std::endl;
+    entry.Run(options);
+    std::cout << std::endl;
+    ranAny = true;
+  }
+
+  if (!ranAny) {
+    PrintUsage();
+    return 1;
+  }
+
+  Logger::Shutdown();
+  return 0;
+}
@@ -0,0 +1,258 @@
+#include "Benchmarks.h"
+#include "HorseEngine/Core/ByteBuffer.h"
+#include "HorseEngine/Core/JobSystem.h"
+#include "HorseEngine/Core/PakReader.h"
+#include "PakWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <physfs.h>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Horse {
+
+static constexpr u32 FileCount = 2000;
+
+static double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+// Packs a mix of cooked-asset-like files with the Packager's writer: JSON
+// text that deflates well and noise that ends up stored
+static void BuildPak(const std::filesystem::path &dir,
+                     const std::filesystem::path &pak) {
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir / "Levels");
+  std::filesystem::create_directories(dir / "Textures");
+
+  const auto level = spdlog::get_level();
+  spdlog::set_level(spdlog::level::warn); // One line per packed file
+  PakWriter writer(pak);
+  std::mt19937 rng(42);
+  for (u32 i = 0; i < FileCount; ++i) {
+    const bool text = (i % 2) == 0;
+    std::string name = text ? fmt::format("Levels/Chunk{}.json", i)
+                            : fmt::format("Textures/Tile{}.bin", i);
+    std::string contents;
+    if (text) {
+      while (contents.size() < 8192 + (rng() % 57344)) {
+        contents += fmt::format("{{\"Entity\":{},\"Position\":[{},{},{}]}},",
+                                rng(), rng() % 100, rng() % 100, rng() % 100);
+      }
+    } else {
+      contents.resize(16384 + (rng() % 114688));
+      for (char &c : contents) {
+        c = static_cast<char>(rng());
+      }
+    }
+    std::ofstream(dir / name, std::ios::binary) << contents;
+    writer.AddFile(dir / name, name);
+  }
+  writer.Finalize();
+  spdlog::set_level(level);
+}
+
+// Files below 'dir' in the PhysFS search path, from its in-memory tree
+static void ListPhysFSFiles(const std::string &dir,
+                            std::vector<std::string> &outNames) {
+  char **files = PHYSFS_enumerateFiles(dir.c_str());
+  if (!files)
+    return;
+  for (char **file = files; *file; ++file) {
+    const std::string path = dir.empty() ? *file : dir + "/" + *file;
+    PHYSFS_Stat stat;
+    if (PHYSFS_stat(path.c_str(), &stat) &&
+        stat.filetype == PHYSFS_FILETYPE_DIRECTORY) {
+      ListPhysFSFiles(path, outNames);
+    } else {
+      outNames.push_back(path);
+    }
+  }
+  PHYSFS_freeList(files);
+}
+
+struct PakTimes {
+  double Mount = 0.0;
+  double Read = 0.0;
+  double Batch = 0.0;
+};
+
+struct PakRun {
+  PakTimes PhysFS;
+  PakTimes Reader;
+  u64 Bytes = 0;
+  u32 Failures = 0;
+};
+
+// Entries are listed from each reader's own index after its mount, outside
+// the timers, and read in name order
+static bool RunPhysFS(const std::string &pak, PakRun &run) {
+  auto start = std::chrono::steady_clock::now();
+  if (PHYSFS_mount(pak.c_str(), "/", 1) == 0) {
+    fmt::print("PhysFS cannot mount {}: {}\n", pak, PHYSFS_getLastError());
+    return false;
+  }
+  run.PhysFS.Mount = Seconds(start);
+
+  std::vector<std::string> names;
+  ListPhysFSFiles("", names);
+  std::sort(names.begin(), names.end());
+
+  start = std::chrono::steady_clock::now();
+  ByteBuffer buffer;
+  for (const std::string &name : names) {
+    PHYSFS_File *file = PHYSFS_openRead(name.c_str());
+    if (!file) {
+      ++run.Failures;
+      continue;
+    }
+    const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+    buffer.resize(length > 0 ? static_cast<size_t>(length) : 0);
+    if (PHYSFS_readBytes(file, buffer.data(), buffer.size()) !=
+        static_cast<PHYSFS_sint64>(buffer.size())) {
+      ++run.Failures;
+    }
+    PHYSFS_close(file);
+  }
+  run.PhysFS.Read = Seconds(start);
+  PHYSFS_unmount(pak.c_str());
+  return true;
+}
+
+static bool RunPakReader(const std::filesystem::path &pak, PakRun &run) {
+  auto start = std::chrono::steady_clock::now();
+  std::unique_ptr<PakReader> reader = PakReader::Open(pak);
+  if (!reader) {
+    fmt::print("PakReader cannot open {}\n", pak.string());
+    return false;
+  }
+  run.Reader.Mount = Seconds(start);
+
+  std::vector<std::string> names;
+  for (const PakEntry &entry : reader->GetEntries()) {
+    names.emplace_back(reader->GetName(entry));
+  }
+  std::sort(names.begin(), names.end());
+
+  start = std::chrono::steady_clock::now();
+  std::vector<const PakEntry *> entries;
+  entries.reserve(names.size());
+  ByteBuffer buffer;
+  run.Bytes = 0;
+  for (const std::string &name : names) {
+    const PakEntry *entry = reader->FindEntry(name);
+    if (!entry || !reader->Read(*entry, buffer)) {
+      ++run.Failures;
+      continue;
+    }
+    entries.push_back(entry);
+    run.Bytes += buffer.size();
+  }
+  run.Reader.Read = Seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  std::vector<ByteBuffer> batch(entries.size());
+  if (!reader->ReadBatch(entries, batch)) {
+    ++run.Failures;
+  }
+  run.Reader.Batch = Seconds(start);
+  return true;
+}
+
+void RunPakBenchmark(const BenchmarkOptions &options) {
+  // Without --pak an archive is generated first, which leaves it in the
+  // page cache. For cold-start numbers, pass an existing archive after a
+  // reboot or after flushing the standby list.
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "HorsePakBenchmark";
+  std::filesystem::path pak = options.PakPath;
+  const bool generated = pak.empty();
+  if (generated) {
+    pak = dir / "Game.pak";
+    BuildPak(dir / "Cooked", pak);
+  }
+  const std::string pakStr = pak.string();
+
+  u32 threads = options.MaxThreads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency() - 1);
+  }
+  JobSystem::Initialize(threads);
+  PHYSFS_init(nullptr);
+
+  // The reader going second runs on pages the first one just loaded, so
+  // the order alternates and the first iteration is reported on its own
+  std::vector<PakRun> runs;
+  bool physfsFirst = options.PakPhysFSFirst;
+  for (u32 it = 0; it < std::max(options.Iterations, 1u); ++it) {
+    PakRun run;
+    const bool ok = physfsFirst
+                        ? RunPhysFS(pakStr, run) && RunPakReader(pak, run)
+                        : RunPakReader(pak, run) && RunPhysFS(pakStr, run);
+    if (!ok)
+      break;
+    runs.push_back(run);
+    physfsFirst = !physfsFirst;
+  }
+
+  PHYSFS_deinit();
+  JobSystem::Shutdown();
+  if (generated) {
+    std::filesystem::remove_all(dir);
+  }
+  if (runs.empty())
+    return;
+
+  PakRun average;
+  for (size_t i = 1; i < runs.size(); ++i) {
+    for (auto [sum, times] : {std::pair{&average.PhysFS, &runs[i].PhysFS},
+                              std::pair{&average.Reader, &runs[i].Reader}}) {
+      sum->Mount += times->Mount;
+      sum->Read += times->Read;
+      sum->Batch += times->Batch;
+    }
+  }
+  const double scale =
+      runs.size() > 1 ? 1000.0 / static_cast<double>(runs.size() - 1) : 0.0;
+  const PakRun &first = runs.front();
+
+  fmt::print("{} ({}), {:.1f} MB uncompressed, {} threads\n", pakStr,
+             generated ? "generated, warm cache" : "as given",
+             first.Bytes / (1024.0 * 1024.0), threads);
+  fmt::print("First iteration: {} went first, the other reader ran on the "
+             "pages it had just loaded\n",
+             options.PakPhysFSFirst ? "PhysFS" : "PakReader");
+  fmt::print("{:>24} {:>14} {:>14} {:>12} {:>12}\n", "reader",
+             "1st mount ms", "1st read ms", "mount ms", "read ms");
+  fmt::print("{:>24} {:>14.3f} {:>14.3f} {:>12.3f} {:>12.3f}\n", "PhysFS",
+             first.PhysFS.Mount * 1000.0, first.PhysFS.Read * 1000.0,
+             average.PhysFS.Mount * scale, average.PhysFS.Read * scale);
+  fmt::print("{:>24} {:>14.3f} {:>14.3f} {:>12.3f} {:>12.3f}\n", "PakReader",
+             first.Reader.Mount * 1000.0, first.Reader.Read * 1000.0,
+             average.Reader.Mount * scale, average.Reader.Read * scale);
+  fmt::print("{:>24} {:>14} {:>14.3f} {:>12} {:>12.3f}\n",
+             "PakReader::ReadBatch", "", first.Reader.Batch * 1000.0, "",
+             average.Reader.Batch * scale);
+  if (runs.size() < 2) {
+    fmt::print("Averages need --iterations 2 or more\n");
+  }
+
+  u32 failures = 0;
+  for (const PakRun &run : runs) {
+    failures += run.Failures;
+  }
+  if (failures > 0) {
+    fmt::print("{} reads failed\n", failures);
+  }
+}
+
+} // namespace Horse
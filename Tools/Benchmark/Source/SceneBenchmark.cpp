@@ -0,0 +1,91 @@
+#include "Benchmarks.h"
+#include "HorseEngine/Core/JobSystem.h"
+#include "HorseEngine/Core/Logging.h"
+#include "HorseEngine/Core/Memory.h"
+#include "HorseEngine/Scene/Components.h"
+#include "HorseEngine/Scene/Entity.h"
+#include "HorseEngine/Scene/Scene.h"
+#include "HorseEngine/Scene/SceneSerializer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fmt/format.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace Horse {
+
+static constexpr u32 RootCount = 1000;
+static constexpr u32 ChildrenPerRoot = 9;
+static constexpr u32 FramesPerIteration = 1000;
+
+static double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+// Shallow hierarchies of renderable entities; strings, maps and components
+// make loading allocation-heavy, like a real level
+static std::string BuildSceneJson() {
+  Scene scene("Benchmark");
+  for (u32 root = 0; root < RootCount; ++root) {
+    Entity parent = scene.CreateEntity(fmt::format("Root {}", root));
+    auto &mesh = parent.AddComponent<MeshRendererComponent>();
+    mesh.MeshGUID = fmt::format("Meshes/Rock{}.mesh", root % 16);
+    mesh.MaterialGUID = fmt::format("Materials/Rock{}.mat", root % 8);
+
+    for (u32 child = 0; child < ChildrenPerRoot; ++child) {
+      Entity entity = scene.CreateEntity(fmt::format("Child {}", child));
+      entity.AddComponent<MeshRendererComponent>().MeshGUID =
+          "Meshes/Pebble.mesh";
+      scene.SetEntityParent(entity, parent);
+    }
+  }
+  return SceneSerializer::SerializeToJSONString(&scene);
+}
+
+void RunSceneBenchmark(const BenchmarkOptions &options) {
+  u32 threads = options.MaxThreads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency() - 1);
+  }
+  JobSystem::Initialize(threads);
+
+  // Entity creation logs every entity; keep that out of the timings
+  auto logger = Logger::GetLogger(LogChannel::Core);
+  const auto level = logger->level();
+  logger->set_level(spdlog::level::warn);
+
+  const std::string json = BuildSceneJson();
+
+  double loadSeconds = 0.0;
+  double updateSeconds = 0.0;
+  for (u32 it = 0; it < options.Iterations; ++it) {
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<Scene> scene =
+        SceneSerializer::DeserializeFromJSONString(json);
+    loadSeconds += Seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (u32 frame = 0; frame < FramesPerIteration; ++frame) {
+      scene->OnUpdate(1.0f / 60.0f);
+    }
+    updateSeconds += Seconds(start);
+  }
+
+  logger->set_level(level);
+  JobSystem::Shutdown();
+
+  const u32 entities = RootCount * (ChildrenPerRoot + 1);
+  fmt::print("heap: {}, {} entities, {} threads\n", GetHeapName(), entities,
+             threads);
+  fmt::print("{:>16} {:>12}\n", "stage", "ms");
+  fmt::print("{:>16} {:>12.3f}\n", "scene load",
+             loadSeconds * 1000.0 / options.Iterations);
+  fmt::print("{:>16} {:>12.3f}\n", "frame update",
+             updateSeconds * 1000.0 / options.Iterations / FramesPerIteration);
+}
+
+} // namespace Horse
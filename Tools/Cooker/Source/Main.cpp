@@ -1,6 +1,7 @@
 #include "CookerRegistry.h"
 #include "HorseEngine/Asset/Asset.h"
 #include "HorseEngine/Asset/AssetManager.h"
+#include "HorseEngine/Core/ByteBuffer.h"
 #include "HorseEngine/Core/Logging.h"
 #include "LevelCooker.h"
 #include "MaterialCooker.h"
@@ -68,6 +69,9 @@ int main(int argc, char **argv) {
 
   Logger::Initialize();
   HORSE_LOG_CORE_INFO("HorseCooker starting...");
+  if (!ByteBuffer::EnableLargePages()) {
+    HORSE_LOG_CORE_INFO("Large pages unavailable, cooking with regular pages");
+  }
   HORSE_LOG_CORE_INFO("Assets Directory: {0}", assetsDir.string());
   HORSE_LOG_CORE_INFO("Output Directory: {0}", outputDir.string());
   HORSE_LOG_CORE_INFO("Target Platform: {0}", platform);
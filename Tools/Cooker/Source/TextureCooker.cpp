@@ -1,4 +1,5 @@
 #include "TextureCooker.h"
+#include "HorseEngine/Core/FileSystem.h"
 #include "HorseEngine/Core/Logging.h"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -24,8 +25,32 @@ bool TextureCooker::Cook(const std::filesystem::path &sourcePath,
                          const CookerContext &context) {
   int width, height, channels;
   stbi_set_flip_vertically_on_load(true);
-  unsigned char *data =
-      stbi_load(sourcePath.string().c_str(), &width, &height, &channels, 4);
+  unsigned char *data = nullptr;
+  if (FileSystem::CanMap(sourcePath)) {
+    // Loose sources are decoded straight from the mapping
+    MappedFile source = FileSystem::Map(sourcePath);
+    if (!source) {
+      HORSE_LOG_CORE_ERROR("Failed to read texture for cooking: {0}",
+                           sourcePath.string());
+      return false;
+    }
+    data = stbi_load_from_memory(source.data(),
+                                 static_cast<int>(source.size()), &width,
+                                 &height, &channels, 4);
+  } else {
+    // Compressed archive entries are inflated chunk by chunk instead
+    std::unique_ptr<FileStream> source = FileSystem::OpenStream(sourcePath);
+    if (!source) {
+      HORSE_LOG_CORE_ERROR("Failed to read texture for cooking: {0}",
+                           sourcePath.string());
+      return false;
+    }
+    const stbi_io_callbacks callbacks = {&FileStream::ReadCallback,
+                                         &FileStream::SkipCallback,
+                                         &FileStream::EofCallback};
+    data = stbi_load_from_callbacks(&callbacks, source.get(), &width, &height,
+                                    &channels, 4);
+  }
 
   if (!data) {
     HORSE_LOG_CORE_ERROR("Failed to load texture for cooking: {0}",
@@ -1,4 +1,5 @@
 #include "PakWriter.h"
+#include "HorseEngine/Core/ByteBuffer.h"
 #ifdef _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -154,6 +155,11 @@ int main(int argc, char **argv) {
     std::filesystem::create_directories(outputDir);
   }
 
+  if (!Horse::ByteBuffer::EnableLargePages()) {
+    std::cout << "Large pages unavailable, packing with regular pages"
+              << std::endl;
+  }
+
   // 1. Create Game.pak
   std::filesystem::path pakPath = outputDir / "Game.pak";
   Horse::PakWriter writer(pakPath);
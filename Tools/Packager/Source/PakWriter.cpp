@@ -1,4 +1,5 @@
 #include "PakWriter.h"
+#include "HorseEngine/Core/ByteBuffer.h"
 #include <ctime>
 #include <filesystem>
 #include <fstream>
@@ -61,6 +62,7 @@ struct ZipEndOfCentralDirectory {
 
 struct ZipEntryInfo {
   std::string filename;
+  uint16_t compressionMethod;
   uint32_t crc32;
   uint32_t compressedSize;
   uint32_t uncompressedSize;
@@ -91,10 +93,11 @@ bool PakWriter::AddFile(const std::filesystem::path &inputPath,
     return false;
   }
 
+  // Raw buffers: both are overwritten right away, no need to zero them
   size_t fileSize = file.tellg();
-  std::vector<char> buffer(fileSize);
+  ByteBuffer buffer(fileSize);
   file.seekg(0);
-  file.read(buffer.data(), fileSize);
+  file.read(reinterpret_cast<char *>(buffer.data()), fileSize);
   file.close();
 
   // 1. Calculate CRC32
@@ -105,7 +108,7 @@ bool PakWriter::AddFile(const std::filesystem::path &inputPath,
   // 2. Compress (Raw Deflate for ZIP)
   // Estimate size
   uLong compressedBound = compressBound((uLong)fileSize);
-  std::vector<char> compressedBuffer(compressedBound);
+  ByteBuffer compressedBuffer(compressedBound);
 
   z_stream defstream;
   defstream.zalloc = Z_NULL;
@@ -129,8 +132,18 @@ bool PakWriter::AddFile(const std::filesystem::path &inputPath,
   uLong compressedSize = defstream.total_out;
   deflateEnd(&defstream);
 
+  // Store entries that deflate barely shrinks (already compressed data):
+  // inflating them would cost more than it saves, and stored entries are
+  // memory-mapped in place by FileSystem::Map
+  const bool store = compressedSize + fileSize / 16 >= fileSize;
+  if (store) {
+    compressedSize = (uLong)fileSize;
+  }
+  const ByteBuffer &payload = store ? buffer : compressedBuffer;
+
   // 3. Write Local Header
   ZipLocalHeader lfh;
+  lfh.compressionMethod = store ? 0 : 8;
   lfh.crc32 = (uint32_t)crc;
   lfh.compressedSize = (uint32_t)compressedSize;
   lfh.uncompressedSize = (uint32_t)fileSize;
@@ -141,11 +154,13 @@ bool PakWriter::AddFile(const std::filesystem::path &inputPath,
   m_OutputStream.write(reinterpret_cast<const char *>(&lfh),
                        sizeof(ZipLocalHeader));
   m_OutputStream.write(entryName.c_str(), entryName.length());
-  m_OutputStream.write(compressedBuffer.data(), compressedSize);
+  m_OutputStream.write(reinterpret_cast<const char *>(payload.data()),
+                       compressedSize);
 
   // Store info for Central Directory
   ZipEntryInfo info;
   info.filename = entryName;
+  info.compressionMethod = lfh.compressionMethod;
   info.crc32 = lfh.crc32;
   info.compressedSize = lfh.compressedSize;
   info.uncompressedSize = lfh.uncompressedSize;
@@ -163,6 +178,7 @@ bool PakWriter::Finalize() {
   // Write Central Directory Headers
   for (const auto &entry : s_Entries) {
     ZipCentralDirectoryHeader cdh;
+    cdh.compressionMethod = entry.compressionMethod;
     cdh.crc32 = entry.crc32;
     cdh.compressedSize = entry.compressedSize;
     cdh.uncompressedSize = entry.uncompressedSize;